@@ -41,6 +41,10 @@ using namespace KIGFX;
 
 BASIC_GAL basic_gal;
 
+#ifdef USE_OPENMP
+    #pragma omp threadprivate( basic_gal )
+#endif
+
 const VECTOR2D BASIC_GAL::transform( const VECTOR2D& aPoint ) const
 {
     VECTOR2D point = aPoint + m_transform.m_moveOffset - m_transform.m_rotCenter;
@@ -43,6 +43,7 @@
 #include <wxstruct.h>
 #include <base_struct.h>
 #include <common.h>
+#include <geometry/shape_line_chain.h>
 #include <plot_common.h>
 #include <macros.h>
 #include <class_base_screen.h>
@@ -89,10 +90,80 @@ bool PLOTTER::OpenFile( const wxString& aFullFilename )
     if( outputFile == NULL )
         return false ;
 
+    setFileBuffer( outputFile, m_outputBuffer );
+
     return true;
 }
 
 
+void PLOTTER::setFileBuffer( FILE* aFile, std::vector<char>& aBuffer )
+{
+    const size_t bufferSize = 256 * 1024;
+
+    aBuffer.resize( bufferSize );
+    setvbuf( aFile, &aBuffer[0], _IOFBF, bufferSize );
+}
+
+
+char* PLOTTER::formatInt( char* aBuffer, int aValue )
+{
+    // Work on the unsigned magnitude, so that INT_MIN has no special case
+    unsigned magnitude = aValue;
+    char     digits[10];
+    int      count = 0;
+
+    if( aValue < 0 )
+    {
+        *aBuffer++ = '-';
+        magnitude = 0u - magnitude;
+    }
+
+    do
+    {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while( magnitude );
+
+    while( count )
+        *aBuffer++ = digits[--count];
+
+    return aBuffer;
+}
+
+
+PLOT_CORNERS::PLOT_CORNERS( const SHAPE_LINE_CHAIN& aChain ) :
+    m_cornerList( NULL ),
+    m_chain( &aChain ),
+    m_count( aChain.PointCount() )
+{
+    if( m_count > 1 && aChain.CPoint( 0 ) != aChain.CPoint( -1 ) )
+        m_count++;
+}
+
+
+wxPoint PLOT_CORNERS::chainCorner( int aIndex ) const
+{
+    // CPoint() wraps the index: the corner PointCount() is the first corner
+    const VECTOR2I& corner = m_chain->CPoint( aIndex );
+
+    return wxPoint( corner.x, corner.y );
+}
+
+
+void PLOTTER::PlotPoly( const SHAPE_LINE_CHAIN& aCornerList, FILL_T aFill, int aWidth )
+{
+    PLOT_CORNERS            corners( aCornerList );
+    std::vector<wxPoint>    cornerList;
+
+    cornerList.reserve( corners.Count() );
+
+    for( int ii = 0; ii < corners.Count(); ii++ )
+        cornerList.push_back( corners[ii] );
+
+    PlotPoly( cornerList, aFill, aWidth );
+}
+
+
 DPOINT PLOTTER::userToDeviceCoordinates( const wxPoint& aCoordinate )
 {
     wxPoint pos = aCoordinate - plotOffset;
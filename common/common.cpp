@@ -266,12 +266,18 @@ time_t GetNewTimeStamp()
     static time_t oldTimeStamp;
     time_t newTimeStamp;
 
-    newTimeStamp = time( NULL );
+    // Items are also created by the threads parsing schematic sheet files.
+#ifdef USE_OPENMP
+    #pragma omp critical( GetNewTimeStamp )
+#endif
+    {
+        newTimeStamp = time( NULL );
 
-    if( newTimeStamp <= oldTimeStamp )
-        newTimeStamp = oldTimeStamp + 1;
+        if( newTimeStamp <= oldTimeStamp )
+            newTimeStamp = oldTimeStamp + 1;
 
-    oldTimeStamp = newTimeStamp;
+        oldTimeStamp = newTimeStamp;
+    }
 
     return newTimeStamp;
 }
@@ -96,9 +96,24 @@ void GERBER_PLOTTER::SetGerberCoordinatesFormat( int aResolution, bool aUseInche
 
 void GERBER_PLOTTER::emitDcode( const DPOINT& pt, int dcode )
 {
+    // Same as fprintf( outputFile, "X%dY%dD%02d*\n", ... ), but a lot faster.
+    char  line[48];
+    char* end = line;
 
-    fprintf( outputFile, "X%dY%dD%02d*\n",
-	    KiROUND( pt.x ), KiROUND( pt.y ), dcode );
+    *end++ = 'X';
+    end = formatInt( end, KiROUND( pt.x ) );
+    *end++ = 'Y';
+    end = formatInt( end, KiROUND( pt.y ) );
+    *end++ = 'D';
+
+    if( dcode >= 0 && dcode < 10 )
+        *end++ = '0';
+
+    end = formatInt( end, dcode );
+    *end++ = '*';
+    *end++ = '\n';
+
+    fwrite( line, 1, end - line, outputFile );
 }
 
 
@@ -118,6 +133,8 @@ bool GERBER_PLOTTER::StartPlot()
     if( outputFile == NULL )
         return false;
 
+    setFileBuffer( workFile, m_workBuffer );
+
     for( unsigned ii = 0; ii < m_headerExtraLines.GetCount(); ii++ )
     {
         if( ! m_headerExtraLines[ii].IsEmpty() )
@@ -176,6 +193,7 @@ bool GERBER_PLOTTER::EndPlot()
     fclose( workFile );
     workFile   = wxFopen( m_workFilename, wxT( "rt" ));
     wxASSERT( workFile );
+    setFileBuffer( workFile, m_workBuffer );
     outputFile = finalFile;
 
     // Placement of apertures in RS274X
@@ -223,27 +241,21 @@ void GERBER_PLOTTER::SetCurrentLineWidth( int width )
 std::vector<APERTURE>::iterator GERBER_PLOTTER::getAperture( const wxSize&           size,
                                                              APERTURE::APERTURE_TYPE type )
 {
-    int last_D_code = 9;
-
     // Search an existing aperture
-    std::vector<APERTURE>::iterator tool = apertures.begin();
+    APERTURE_KEY key( type, size );
 
-    while( tool != apertures.end() )
-    {
-        last_D_code = tool->DCode;
-
-        if( (tool->Type == type) && (tool->Size == size) )
-            return tool;
+    auto index = m_apertureIndex.find( key );
 
-        tool++;
-    }
+    if( index != m_apertureIndex.end() )
+        return apertures.begin() + index->second;
 
     // Allocate a new aperture
     APERTURE new_tool;
     new_tool.Size  = size;
     new_tool.Type  = type;
-    new_tool.DCode = last_D_code + 1;
+    new_tool.DCode = apertures.empty() ? 10 : apertures.back().DCode + 1;
     apertures.push_back( new_tool );
+    m_apertureIndex[key] = apertures.size() - 1;
     return apertures.end() - 1;
 }
 
@@ -339,6 +351,38 @@ void GERBER_PLOTTER::PenTo( const wxPoint& aPos, char plume )
 }
 
 
+void GERBER_PLOTTER::PlotRegions( const SHAPE_POLY_SET& aPolygons )
+{
+    if( aPolygons.IsEmpty() )
+        return;
+
+    fputs( "G36*\n", outputFile );
+
+    bool    contourStart = true;
+    wxPoint first;
+
+    for( SHAPE_POLY_SET::CONST_ITERATOR ic = aPolygons.CIterate(); ic; ++ic )
+    {
+        wxPoint pos( ic->x, ic->y );
+
+        if( contourStart )
+        {
+            MoveTo( pos );
+            first = pos;
+        }
+        else
+            LineTo( pos );
+
+        contourStart = ic.IsEndContour();
+
+        if( contourStart )     // Close the contour
+            FinishTo( first );
+    }
+
+    fputs( "G37*\n", outputFile );
+}
+
+
 void GERBER_PLOTTER::Rect( const wxPoint& p1, const wxPoint& p2, FILL_T fill, int width )
 {
     std::vector< wxPoint > cornerList;
@@ -394,7 +438,22 @@ void GERBER_PLOTTER::Arc( const wxPoint& aCenter, double aStAngle, double aEndAn
 void GERBER_PLOTTER:: PlotPoly( const std::vector< wxPoint >& aCornerList,
                                FILL_T aFill, int aWidth )
 {
-    if( aCornerList.size() <= 1 )
+    plotCorners( PLOT_CORNERS( aCornerList ), aFill, aWidth );
+}
+
+
+void GERBER_PLOTTER::PlotPoly( const SHAPE_LINE_CHAIN& aCornerList,
+                               FILL_T aFill, int aWidth )
+{
+    plotCorners( PLOT_CORNERS( aCornerList ), aFill, aWidth );
+}
+
+
+void GERBER_PLOTTER::plotCorners( const PLOT_CORNERS& aCorners, FILL_T aFill, int aWidth )
+{
+    int count = aCorners.Count();
+
+    if( count <= 1 )
         return;
 
     // Gerber format does not know filled polygons with thick outline
@@ -407,26 +466,26 @@ void GERBER_PLOTTER:: PlotPoly( const std::vector< wxPoint >& aCornerList,
     {
         fputs( "G36*\n", outputFile );
 
-        MoveTo( aCornerList[0] );
+        MoveTo( aCorners[0] );
 
-        for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
-            LineTo( aCornerList[ii] );
+        for( int ii = 1; ii < count; ii++ )
+            LineTo( aCorners[ii] );
 
-        FinishTo( aCornerList[0] );
+        FinishTo( aCorners[0] );
         fputs( "G37*\n", outputFile );
     }
 
     if( aWidth > 0 )
     {
-        MoveTo( aCornerList[0] );
+        MoveTo( aCorners[0] );
 
-        for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
-            LineTo( aCornerList[ii] );
+        for( int ii = 1; ii < count; ii++ )
+            LineTo( aCorners[ii] );
 
         // Ensure the thick outline is closed for filled polygons
         // (if not filled, could be only a polyline)
-        if( aFill && ( aCornerList[aCornerList.size()-1] != aCornerList[0] ) )
-            LineTo( aCornerList[0] );
+        if( aFill && ( aCorners[count-1] != aCorners[0] ) )
+            LineTo( aCorners[0] );
 
         PenFinish();
     }
@@ -317,11 +317,26 @@ void HPGL_PLOTTER::Circle( const wxPoint& centre, int diameter, FILL_T fill,
 void HPGL_PLOTTER::PlotPoly( const std::vector<wxPoint>& aCornerList,
                              FILL_T aFill, int aWidth )
 {
-    if( aCornerList.size() <= 1 )
+    plotCorners( PLOT_CORNERS( aCornerList ), aFill, aWidth );
+}
+
+
+void HPGL_PLOTTER::PlotPoly( const SHAPE_LINE_CHAIN& aCornerList,
+                             FILL_T aFill, int aWidth )
+{
+    plotCorners( PLOT_CORNERS( aCornerList ), aFill, aWidth );
+}
+
+
+void HPGL_PLOTTER::plotCorners( const PLOT_CORNERS& aCorners, FILL_T aFill, int aWidth )
+{
+    int count = aCorners.Count();
+
+    if( count <= 1 )
         return;
 
     SetCurrentLineWidth( aWidth );
-    MoveTo( aCornerList[0] );
+    MoveTo( aCorners[0] );
 
     if( aFill == FILLED_SHAPE )
     {
@@ -329,30 +344,23 @@ void HPGL_PLOTTER::PlotPoly( const std::vector<wxPoint>& aCornerList,
         SetCurrentLineWidth( USE_DEFAULT_LINE_WIDTH );
         fprintf( outputFile, "PM 0;\n" );       // Start polygon
 
-        for( unsigned ii = 1; ii < aCornerList.size(); ++ii )
-            LineTo( aCornerList[ii] );
-
-        int ii = aCornerList.size() - 1;
+        for( int ii = 1; ii < count; ++ii )
+            LineTo( aCorners[ii] );
 
-        if( aCornerList[ii] != aCornerList[0] )
-            LineTo( aCornerList[0] );
+        if( aCorners[count - 1] != aCorners[0] )
+            LineTo( aCorners[0] );
 
         fprintf( outputFile, hpgl_end_polygon_cmd );   // Close, fill polygon and draw outlines
     }
     else
     {
         // Plot only the polygon outline.
-        for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
-            LineTo( aCornerList[ii] );
+        for( int ii = 1; ii < count; ii++ )
+            LineTo( aCorners[ii] );
 
         // Always close polygon if filled.
-        if( aFill )
-        {
-            int ii = aCornerList.size() - 1;
-
-            if( aCornerList[ii] != aCornerList[0] )
-                LineTo( aCornerList[0] );
-        }
+        if( aFill && aCorners[count - 1] != aCorners[0] )
+            LineTo( aCorners[0] );
     }
 
     PenFinish();
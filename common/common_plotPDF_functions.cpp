@@ -39,6 +39,15 @@
 #include <wx/zstream.h>
 #include <wx/mstream.h>
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif /* USE_OPENMP */
+
+
+/* The page streams are compressed in parallel, by batches: a batch is flushed
+   when the uncompressed size of its streams reaches this value */
+static const size_t pendingStreamsMaxSize = 64 * 1024 * 1024;
+
 
 /*
  * Open or create the plot file aFullFilename
@@ -58,6 +67,8 @@ bool PDF_PLOTTER::OpenFile( const wxString& aFullFilename )
     if( outputFile == NULL )
         return false ;
 
+    setFileBuffer( outputFile, m_outputBuffer );
+
     return true;
 }
 
@@ -264,19 +275,34 @@ void PDF_PLOTTER::Arc( const wxPoint& centre, double StAngle, double EndAngle, i
  */
 void PDF_PLOTTER::PlotPoly( const std::vector< wxPoint >& aCornerList,
                            FILL_T aFill, int aWidth )
+{
+    plotCorners( PLOT_CORNERS( aCornerList ), aFill, aWidth );
+}
+
+
+void PDF_PLOTTER::PlotPoly( const SHAPE_LINE_CHAIN& aCornerList,
+                            FILL_T aFill, int aWidth )
+{
+    plotCorners( PLOT_CORNERS( aCornerList ), aFill, aWidth );
+}
+
+
+void PDF_PLOTTER::plotCorners( const PLOT_CORNERS& aCorners, FILL_T aFill, int aWidth )
 {
     wxASSERT( workFile );
-    if( aCornerList.size() <= 1 )
+    int count = aCorners.Count();
+
+    if( count <= 1 )
         return;
 
     SetCurrentLineWidth( aWidth );
 
-    DPOINT pos = userToDeviceCoordinates( aCornerList[0] );
+    DPOINT pos = userToDeviceCoordinates( aCorners[0] );
     fprintf( workFile, "%g %g m\n", pos.x, pos.y );
 
-    for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
+    for( int ii = 1; ii < count; ii++ )
     {
-        pos = userToDeviceCoordinates( aCornerList[ii] );
+        pos = userToDeviceCoordinates( aCorners[ii] );
         fprintf( workFile, "%g %g l\n", pos.x, pos.y );
     }
 
@@ -430,30 +456,40 @@ void PDF_PLOTTER::closePdfObject()
  * Pass -1 (default) for a fresh object. Especially from PDF 1.5 streams
  * can contain a lot of things, but for the moment we only handle page
  * content.
+ * The stream object is written later, compressed, by flushPdfStreams()
  */
 int PDF_PLOTTER::startPdfStream(int handle)
 {
     wxASSERT( outputFile );
     wxASSERT( !workFile );
-    handle = startPdfObject( handle );
 
-    // This is guaranteed to be handle+1 but needs to be allocated since
-    // you could allocate more object during stream preparation
+    if( handle < 0 )
+        handle = allocPdfObject();
+
+    // The length is known only when the stream is compressed: it is a deferred
+    // indirect object
     streamLengthHandle = allocPdfObject();
-    fprintf( outputFile,
-             "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
-             "stream\n", handle + 1 );
+
+    PENDING_STREAM stream;
+    stream.handle = handle;
+    stream.lengthHandle = streamLengthHandle;
+    pendingStreams.push_back( stream );
 
     // Open a temporary file to accumulate the stream
     workFilename = filename + wxT(".tmp");
     workFile = wxFopen( workFilename, wxT( "w+b" ));
     wxASSERT( workFile );
+
+    if( workFile )
+        setFileBuffer( workFile, workBuffer );
+
     return handle;
 }
 
 
 /**
- * Finish the current PDF stream (writes the deferred length, too)
+ * Finish the current PDF stream. Its content is kept in RAM until
+ * flushPdfStreams() compresses it along with the other pending streams
  */
 void PDF_PLOTTER::closePdfStream()
 {
@@ -467,51 +503,98 @@ void PDF_PLOTTER::closePdfStream()
         return;
     }
 
-    // Rewind the file, read in the page stream and DEFLATE it
+    // Rewind the file and read in the page stream
+    std::vector<char>& data = pendingStreams.back().data;
+
     fseek( workFile, 0, SEEK_SET );
-    unsigned char *inbuf = new unsigned char[stream_len];
+    data.resize( stream_len );
 
-    int rc = fread( inbuf, 1, stream_len, workFile );
-    wxASSERT( rc == stream_len );
-    (void) rc;
+    if( stream_len > 0 )
+    {
+        int rc = fread( &data[0], 1, stream_len, workFile );
+        wxASSERT( rc == stream_len );
+        (void) rc;
+    }
 
     // We are done with the temporary file, junk it
     fclose( workFile );
     workFile = 0;
     ::wxRemoveFile( workFilename );
 
-    // NULL means memos owns the memory, but provide a hint on optimum size needed.
-    wxMemoryOutputStream    memos( NULL, std::max( 2000l, stream_len ) ) ;
+    pendingStreamsSize += stream_len;
+
+    if( pendingStreamsSize >= pendingStreamsMaxSize )
+        flushPdfStreams();
+}
+
+
+/**
+ * DEFLATE the pending streams, each one by its own thread, and write them
+ * (and their deferred length) in the order they were opened
+ */
+void PDF_PLOTTER::flushPdfStreams()
+{
+    wxASSERT( outputFile );
+    wxASSERT( !workFile );
+
+    int count = pendingStreams.size();
 
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for( int ii = 0; ii < count; ii++ )
     {
-        /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
-         * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
-         * stream! (a DEFLATE stream would be generated with -15 instead of 15)
-         * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
-         *                    8, Z_DEFAULT_STRATEGY );
-         */
+        std::vector<char>& data = pendingStreams[ii].data;
 
-        wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+        // NULL means memos owns the memory, but provide a hint on optimum size needed.
+        wxMemoryOutputStream    memos( NULL, std::max( (size_t) 2000, data.size() ) );
 
-        zos.Write( inbuf, stream_len );
+        {
+            /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
+             * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
+             * stream! (a DEFLATE stream would be generated with -15 instead of 15)
+             * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
+             *                    8, Z_DEFAULT_STRATEGY );
+             */
 
-        delete[] inbuf;
+            wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
 
-    }   // flush the zip stream using zos destructor
+            if( !data.empty() )
+                zos.Write( &data[0], data.size() );
 
-    wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+        }   // flush the zip stream using zos destructor
 
-    unsigned out_count = sb->Tell();
+        wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+        const char*     compressed = (const char*) sb->GetBufferStart();
 
-    fwrite( sb->GetBufferStart(), 1, out_count, outputFile );
+        // Replace the content by its compressed version, and free the former one
+        std::vector<char>( compressed, compressed + sb->Tell() ).swap( data );
+    }
 
-    fputs( "endstream\n", outputFile );
-    closePdfObject();
+    for( int ii = 0; ii < count; ii++ )
+    {
+        const PENDING_STREAM& stream = pendingStreams[ii];
+        unsigned out_count = stream.data.size();
 
-    // Writing the deferred length as an indirect object
-    startPdfObject( streamLengthHandle );
-    fprintf( outputFile, "%u\n", out_count );
-    closePdfObject();
+        startPdfObject( stream.handle );
+        fprintf( outputFile,
+                 "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
+                 "stream\n", stream.lengthHandle );
+
+        if( out_count )
+            fwrite( &stream.data[0], 1, out_count, outputFile );
+
+        fputs( "endstream\n", outputFile );
+        closePdfObject();
+
+        // Writing the deferred length as an indirect object
+        startPdfObject( stream.lengthHandle );
+        fprintf( outputFile, "%u\n", out_count );
+        closePdfObject();
+    }
+
+    pendingStreams.clear();
+    pendingStreamsSize = 0;
 }
 
 /**
@@ -547,7 +630,7 @@ void PDF_PLOTTER::ClosePage()
 {
     wxASSERT( workFile );
 
-    // Close the page stream (and compress it)
+    // Close the page stream (it is compressed later, with the next pages)
     closePdfStream();
 
     // Emit the page object and put it in the page list for later
@@ -624,6 +707,9 @@ bool PDF_PLOTTER::EndPlot()
     // Close the current page (often the only one)
     ClosePage();
 
+    // Write the page streams not yet written
+    flushPdfStreams();
+
     /* We need to declare the resources we're using (fonts in particular)
        The useful standard one is the Helvetica family. Adding external fonts
        is *very* involved! */
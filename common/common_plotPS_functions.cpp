@@ -143,9 +143,8 @@ void PSLIKE_PLOTTER::FlashPadCircle( const wxPoint& aPadPos, int aDiameter,
 void PSLIKE_PLOTTER::FlashPadRect( const wxPoint& aPadPos, const wxSize& aSize,
                                    double aPadOrient, EDA_DRAW_MODE_T aTraceMode )
 {
-    static std::vector< wxPoint > cornerList;
+    std::vector< wxPoint > cornerList;
     wxSize size( aSize );
-    cornerList.clear();
 
     if( aTraceMode == FILLED )
         SetCurrentLineWidth( 0 );
@@ -263,8 +262,7 @@ void PSLIKE_PLOTTER::FlashPadCustom( const wxPoint& aPadPos, const wxSize& aSize
 void PSLIKE_PLOTTER::FlashPadTrapez( const wxPoint& aPadPos, const wxPoint *aCorners,
                                      double aPadOrient, EDA_DRAW_MODE_T aTraceMode )
 {
-    static std::vector< wxPoint > cornerList;
-    cornerList.clear();
+    std::vector< wxPoint > cornerList;
 
     for( int ii = 0; ii < 4; ii++ )
         cornerList.push_back( aCorners[ii] );
@@ -616,17 +614,32 @@ void PS_PLOTTER::Arc( const wxPoint& centre, double StAngle, double EndAngle,
 void PS_PLOTTER::PlotPoly( const std::vector< wxPoint >& aCornerList,
                            FILL_T aFill, int aWidth )
 {
-    if( aCornerList.size() <= 1 )
+    plotCorners( PLOT_CORNERS( aCornerList ), aFill, aWidth );
+}
+
+
+void PS_PLOTTER::PlotPoly( const SHAPE_LINE_CHAIN& aCornerList,
+                           FILL_T aFill, int aWidth )
+{
+    plotCorners( PLOT_CORNERS( aCornerList ), aFill, aWidth );
+}
+
+
+void PS_PLOTTER::plotCorners( const PLOT_CORNERS& aCorners, FILL_T aFill, int aWidth )
+{
+    int count = aCorners.Count();
+
+    if( count <= 1 )
         return;
 
     SetCurrentLineWidth( aWidth );
 
-    DPOINT pos = userToDeviceCoordinates( aCornerList[0] );
+    DPOINT pos = userToDeviceCoordinates( aCorners[0] );
     fprintf( outputFile, "newpath\n%g %g moveto\n", pos.x, pos.y );
 
-    for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
+    for( int ii = 1; ii < count; ii++ )
     {
-        pos = userToDeviceCoordinates( aCornerList[ii] );
+        pos = userToDeviceCoordinates( aCorners[ii] );
         fprintf( outputFile, "%g %g lineto\n", pos.x, pos.y );
     }
 
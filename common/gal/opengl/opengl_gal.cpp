@@ -494,9 +494,14 @@ void OPENGL_GAL::DrawArc( const VECTOR2D& aCenterPoint, double aRadius, double a
     Save();
     currentManager->Translate( aCenterPoint.x, aCenterPoint.y, 0.0 );
 
+    // Points on the arc are obtained by rotating the previous one by alphaIncrement,
+    // so there is no need to evaluate sin() & cos() for every vertex
+    const double alphaIncrement = 2.0 * M_PI / CIRCLE_POINTS;
+    const double cosIncrement = cos( alphaIncrement );
+    const double sinIncrement = sin( alphaIncrement );
+
     if( isStrokeEnabled )
     {
-        const double alphaIncrement = 2.0 * M_PI / CIRCLE_POINTS;
         currentManager->Color( strokeColor.r, strokeColor.g, strokeColor.b, strokeColor.a );
 
         VECTOR2D p( cos( aStartAngle ) * aRadius, sin( aStartAngle ) * aRadius );
@@ -504,7 +509,8 @@ void OPENGL_GAL::DrawArc( const VECTOR2D& aCenterPoint, double aRadius, double a
 
         for( alpha = aStartAngle + alphaIncrement; alpha <= aEndAngle; alpha += alphaIncrement )
         {
-            VECTOR2D p_next( cos( alpha ) * aRadius, sin( alpha ) * aRadius );
+            VECTOR2D p_next( p.x * cosIncrement - p.y * sinIncrement,
+                             p.x * sinIncrement + p.y * cosIncrement );
             DrawLine( p, p_next );
 
             p = p_next;
@@ -520,28 +526,43 @@ void OPENGL_GAL::DrawArc( const VECTOR2D& aCenterPoint, double aRadius, double a
 
     if( isFillEnabled )
     {
-        const double alphaIncrement = 2 * M_PI / CIRCLE_POINTS;
         double alpha;
+        int triangles = 1;      // the last one is always there
+
+        for( alpha = aStartAngle; ( alpha + alphaIncrement ) < aEndAngle; alpha += alphaIncrement )
+            ++triangles;
+
         currentManager->Color( fillColor.r, fillColor.g, fillColor.b, fillColor.a );
         currentManager->Shader( SHADER_NONE );
 
+        // The whole fan is stored in a single chunk
+        if( !currentManager->Reserve( 3 * triangles ) )
+        {
+            Restore();
+            return;
+        }
+
+        VECTOR2D p( cos( aStartAngle ) * aRadius, sin( aStartAngle ) * aRadius );
+
         // Triangle fan
-        for( alpha = aStartAngle; ( alpha + alphaIncrement ) < aEndAngle; )
+        for( int i = 1; i < triangles; ++i )
         {
-            currentManager->Reserve( 3 );
+            VECTOR2D p_next( p.x * cosIncrement - p.y * sinIncrement,
+                             p.x * sinIncrement + p.y * cosIncrement );
+
             currentManager->Vertex( 0.0, 0.0, 0.0 );
-            currentManager->Vertex( cos( alpha ) * aRadius, sin( alpha ) * aRadius, 0.0 );
-            alpha += alphaIncrement;
-            currentManager->Vertex( cos( alpha ) * aRadius, sin( alpha ) * aRadius, 0.0 );
+            currentManager->Vertex( p.x, p.y, 0.0 );
+            currentManager->Vertex( p_next.x, p_next.y, 0.0 );
+
+            p = p_next;
         }
 
         // The last missing triangle
         const VECTOR2D endPoint( cos( aEndAngle ) * aRadius, sin( aEndAngle ) * aRadius );
 
-        currentManager->Reserve( 3 );
         currentManager->Vertex( 0.0, 0.0, 0.0 );
-        currentManager->Vertex( cos( alpha ) * aRadius, sin( alpha ) * aRadius, 0.0 );
-        currentManager->Vertex( endPoint.x,    endPoint.y,     0.0 );
+        currentManager->Vertex( p.x, p.y, 0.0 );
+        currentManager->Vertex( endPoint.x, endPoint.y, 0.0 );
     }
 
     Restore();
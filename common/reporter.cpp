@@ -63,6 +63,16 @@ REPORTER& WX_HTML_PANEL_REPORTER::Report( const wxString& aText, SEVERITY aSever
     return *this;
 }
 
+REPORTER& CONSOLE_REPORTER::Report( const wxString& aText, SEVERITY aSeverity )
+{
+    FILE* out = ( aSeverity == RPT_ERROR ) ? stderr : stdout;
+
+    fprintf( out, "%s\n", TO_UTF8( aText ) );
+    fflush( out );
+
+    return *this;
+}
+
 REPORTER& NULL_REPORTER::Report( const wxString& aText, SEVERITY aSeverity )
 {
     return *this;
@@ -60,9 +60,18 @@ KIWAY    Kiway( &Pgm(), KFCTL_STANDALONE );
  */
 static struct PGM_SINGLE_TOP : public PGM_BASE
 {
+    PGM_SINGLE_TOP() :
+        m_batch( false ),
+        m_batchExitCode( 0 )
+    {
+    }
+
     bool OnPgmInit( wxApp* aWxApp );                    // overload PGM_BASE virtual
     void OnPgmExit();                                   // overload PGM_BASE virtual
     void MacOpenFile( const wxString& aFileName );      // overload PGM_BASE virtual
+
+    bool    m_batch;            ///< a "--batch" job ran instead of the top window
+    int     m_batchExitCode;    ///< what the KIFACE_BATCH_FUNC returned
 } program;
 
 
@@ -134,7 +143,10 @@ struct APP_SINGLE_TOP : public wxApp
 
         try
         {
-            ret = wxApp::OnRun();
+            if( program.m_batch )
+                ret = program.m_batchExitCode;
+            else
+                ret = wxApp::OnRun();
         }
         catch( const std::exception& e )
         {
@@ -204,6 +216,32 @@ bool PGM_SINGLE_TOP::OnPgmInit( wxApp* aWxApp )
     Kiway.set_kiface( KIWAY::KifaceType( TOP_FRAME ), kiface );
 #endif
 
+    // "--batch" hands the remaining arguments to the KIFACE, which runs the job
+    // without creating any window.  OnRun() then returns the job's exit code.
+    if( App().argc > 1 && wxString( App().argv[1] ) == wxT( "--batch" ) )
+    {
+        KIFACE* face = Kiway.KiFACE( KIWAY::KifaceType( TOP_FRAME ) );
+
+        KIFACE_BATCH_FUNC* batch = face ?
+                (KIFACE_BATCH_FUNC*) face->IfaceOrAddress( KIFACE_ADDR_BATCH ) : NULL;
+
+        if( !batch )
+        {
+            wxLogError( wxT( "This program has no batch mode" ) );
+            return false;
+        }
+
+        std::vector<wxString>   argSet;
+
+        for( int i = 2;  i < App().argc;  ++i )
+            argSet.push_back( App().argv[i] );
+
+        m_batch = true;
+        m_batchExitCode = batch( &Kiway, argSet );
+
+        return true;
+    }
+
     // Use KIWAY to create a top window, which registers its existence also.
     // "TOP_FRAME" is a macro that is passed on compiler command line from CMake,
     // and is one of the types in FRAME_T.
@@ -709,7 +709,11 @@ struct VIEW::recacheItem
             gal->DeleteGroup( group );
 
         aItem->setGroup( layer, -1 );
-        aItem->ViewUpdate( VIEW_ITEM::ALL );
+
+        // Neither the bounding box nor the layer set change when recaching, so the item
+        // does not have to be reindexed. Children (e.g. pads of a module) are visited
+        // on their own, hence the non-virtual call.
+        aItem->VIEW_ITEM::ViewUpdate( VIEW_ITEM::REPAINT );
 
         return true;
     }
@@ -848,7 +852,7 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
 
         if( IsCached( layerId ) )
         {
-            if( aUpdateFlags & ( VIEW_ITEM::GEOMETRY | VIEW_ITEM::LAYERS ) )
+            if( aUpdateFlags & ( VIEW_ITEM::GEOMETRY | VIEW_ITEM::LAYERS | VIEW_ITEM::REPAINT ) )
                 updateItemGeometry( aItem, layerId );
             else if( aUpdateFlags & VIEW_ITEM::COLOR )
                 updateItemColor( aItem, layerId );
@@ -108,6 +108,15 @@ const wxString LIB_ALIAS::GetLibraryName()
 }
 
 
+LIB_PART* LIB_ALIAS::GetPart() const
+{
+    if( shared )
+        shared->EnsureDrawItemsParsed();
+
+    return shared;
+}
+
+
 bool LIB_ALIAS::IsRoot() const
 {
     return name == shared->GetName();
@@ -230,7 +239,7 @@ LIB_PART::LIB_PART( LIB_PART& aPart, PART_LIB* aLibrary ) :
 
         newItem = (LIB_ITEM*) oldItem.Clone();
         newItem->SetParent( this );
-        drawings.push_back( newItem );
+        GetDrawItemList().push_back( newItem );
     }
 
     for( size_t i = 0; i < aPart.m_aliases.size(); i++ )
@@ -326,7 +335,7 @@ void LIB_PART::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDc, const wxPoint& aOffset,
     if( ! (screen && screen->m_IsPrinting && GetGRForceBlackPenState())
             && (aColor == UNSPECIFIED_COLOR) )
     {
-        for( LIB_ITEM& drawItem : drawings )
+        for( LIB_ITEM& drawItem : GetDrawItemList() )
         {
             if( drawItem.m_Fill != FILLED_WITH_BG_BODYCOLOR )
                 continue;
@@ -362,7 +371,7 @@ void LIB_PART::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDc, const wxPoint& aOffset,
     // Track the index into the dangling pins list
     size_t pin_index = 0;
 
-    for( LIB_ITEM& drawItem : drawings )
+    for( LIB_ITEM& drawItem : GetDrawItemList() )
     {
         if( aOnlySelected && !drawItem.IsSelected() )
             continue;
@@ -445,7 +454,7 @@ void LIB_PART::Plot( PLOTTER* aPlotter, int aUnit, int aConvert,
 
     // draw background for filled items using background option
     // Solid lines will be drawn after the background
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         // Lib Fields are not plotted here, because this plot function
         // is used to plot schematic items, which have they own fields
@@ -464,7 +473,7 @@ void LIB_PART::Plot( PLOTTER* aPlotter, int aUnit, int aConvert,
 
     // Not filled items and filled shapes are now plotted
     // (plot only items which are not already plotted)
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( item.Type() == LIB_FIELD_T )
             continue;
@@ -488,7 +497,7 @@ void LIB_PART::PlotLibFields( PLOTTER* aPlotter, int aUnit, int aConvert,
     aPlotter->SetColor( GetLayerColor( LAYER_FIELDS ) );
     bool fill = aPlotter->GetColorMode();
 
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( item.Type() != LIB_FIELD_T )
             continue;
@@ -536,7 +545,7 @@ void LIB_PART::RemoveDrawItem( LIB_ITEM* aItem, EDA_DRAW_PANEL* aPanel, wxDC* aD
 
     LIB_ITEMS::iterator i;
 
-    for( i = drawings.begin(); i != drawings.end(); i++ )
+    for( i = GetDrawItemList().begin(); i != GetDrawItemList().end(); i++ )
     {
         if( *i == aItem )
         {
@@ -544,7 +553,7 @@ void LIB_PART::RemoveDrawItem( LIB_ITEM* aItem, EDA_DRAW_PANEL* aPanel, wxDC* aD
                 aItem->Draw( aPanel, aDc, wxPoint( 0, 0 ), UNSPECIFIED_COLOR,
                              g_XorMode, NULL, DefaultTransform );
 
-            drawings.erase( i );
+            GetDrawItemList().erase( i );
             SetModified();
             break;
         }
@@ -556,8 +565,8 @@ void LIB_PART::AddDrawItem( LIB_ITEM* aItem )
 {
     wxASSERT( aItem != NULL );
 
-    drawings.push_back( aItem );
-    drawings.sort();
+    GetDrawItemList().push_back( aItem );
+    GetDrawItemList().sort();
 }
 
 
@@ -566,20 +575,20 @@ LIB_ITEM* LIB_PART::GetNextDrawItem( LIB_ITEM* aItem, KICAD_T aType )
     /* Return the next draw object pointer.
      * If item is NULL return the first item of type in the list.
      */
-    if( drawings.empty() )
+    if( GetDrawItemList().empty() )
         return NULL;
 
     if( aItem == NULL && aType == TYPE_NOT_INIT )    // type is unspecified
-        return &drawings[0];
+        return &GetDrawItemList()[0];
 
     // Search for last item
     size_t idx = 0;
 
     if( aItem )
     {
-        for( ; idx < drawings.size(); idx++ )
+        for( ; idx < GetDrawItemList().size(); idx++ )
         {
-            if( aItem == &drawings[idx] )
+            if( aItem == &GetDrawItemList()[idx] )
             {
                 idx++;   // Prepare the next item search
                 break;
@@ -588,10 +597,10 @@ LIB_ITEM* LIB_PART::GetNextDrawItem( LIB_ITEM* aItem, KICAD_T aType )
     }
 
     // Search the next item
-    for( ; idx < drawings.size(); idx++ )
+    for( ; idx < GetDrawItemList().size(); idx++ )
     {
-        if( aType == TYPE_NOT_INIT || drawings[ idx ].Type() == aType )
-            return &drawings[ idx ];
+        if( aType == TYPE_NOT_INIT || GetDrawItemList()[ idx ].Type() == aType )
+            return &GetDrawItemList()[ idx ];
     }
 
     return NULL;
@@ -606,7 +615,7 @@ void LIB_PART::GetPins( LIB_PINS& aList, int aUnit, int aConvert )
      * when .m_Unit == 0, the body item is common to units
      * when .m_Convert == 0, the body item is common to shapes
      */
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( item.Type() != LIB_PIN_T )    // we search pins only
             continue;
@@ -813,15 +822,15 @@ bool LIB_PART::Save( OUTPUTFORMATTER& aFormatter )
     }
 
     // Save graphics items (including pins)
-    if( !drawings.empty() )
+    if( !GetDrawItemList().empty() )
     {
         /* we sort the draw items, in order to have an edition more easy,
          *  when a file editing "by hand" is made */
-        drawings.sort();
+        GetDrawItemList().sort();
 
         aFormatter.Print( 0, "DRAW\n" );
 
-        for( LIB_ITEM& item : drawings )
+        for( LIB_ITEM& item : GetDrawItemList() )
         {
             if( item.Type() == LIB_FIELD_T )
                 continue;
@@ -957,7 +966,7 @@ bool LIB_PART::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
         else if( strcmp( p, "ENDDEF" ) == 0 )   // End of component description
             goto ok;
         else if( strcmp( p, "DRAW" ) == 0 )
-            result = LoadDrawEntries( aLineReader, Msg );
+            result = readDrawSection( aLineReader, Msg );
         else if( strncmp( p, "ALIAS", 5 ) == 0 )
         {
             p = strtok( NULL, "\r\n" );
@@ -989,6 +998,46 @@ ok:
 }
 
 
+bool LIB_PART::readDrawSection( LINE_READER& aLineReader, wxString& aErrorMsg )
+{
+    char* line;
+
+    // Only keep the text of the DRAW section here: most parts of a library are never
+    // drawn, and building their draw items is most of the library loading time.
+    while( ( line = aLineReader.ReadLine() ) != NULL )
+    {
+        m_drawSection.append( line, aLineReader.Length() );
+
+        if( m_drawSection.empty() || m_drawSection[ m_drawSection.size() - 1 ] != '\n' )
+            m_drawSection += '\n';
+
+        if( strncmp( line, "ENDDRAW", 7 ) == 0 )
+            return true;
+    }
+
+    aErrorMsg = wxT( "file ended prematurely loading component draw element" );
+    return false;
+}
+
+
+void LIB_PART::loadDrawSection()
+{
+    // LoadDrawEntries() adds the items to drawings, clear the pending text first.
+    std::string section;
+
+    section.swap( m_drawSection );
+
+    STRING_LINE_READER  reader( section, m_name );
+    wxString            msg;
+
+    if( !LoadDrawEntries( reader, msg ) )
+        wxLogWarning( _( "Component '%s' draw load error: %s at line %d." ),
+                      GetChars( m_name ), GetChars( msg ), reader.LineNumber() );
+
+    drawings.sort();
+}
+
+
 bool LIB_PART::LoadDrawEntries( LINE_READER& aLineReader, wxString& aErrorMsg )
 {
     char* line;
@@ -1158,9 +1207,9 @@ const EDA_RECT LIB_PART::GetBoundingBox( int aUnit, int aConvert ) const
     EDA_RECT bBox;
     bool initialized = false;
 
-    for( unsigned ii = 0; ii < drawings.size(); ii++  )
+    for( unsigned ii = 0; ii < drawItems().size(); ii++  )
     {
-        const LIB_ITEM& item = drawings[ii];
+        const LIB_ITEM& item = drawItems()[ii];
 
         if( ( item.m_Unit > 0 ) && ( ( m_unitCount > 1 ) && ( aUnit > 0 )
                                      && ( aUnit != item.m_Unit ) ) )
@@ -1190,9 +1239,9 @@ const EDA_RECT LIB_PART::GetBodyBoundingBox( int aUnit, int aConvert ) const
     EDA_RECT bBox;
     bool initialized = false;
 
-    for( unsigned ii = 0; ii < drawings.size(); ii++  )
+    for( unsigned ii = 0; ii < drawItems().size(); ii++  )
     {
-        const LIB_ITEM& item = drawings[ii];
+        const LIB_ITEM& item = drawItems()[ii];
 
         if( ( item.m_Unit > 0 ) && ( ( m_unitCount > 1 ) && ( aUnit > 0 )
                                      && ( aUnit != item.m_Unit ) ) )
@@ -1221,7 +1270,7 @@ void LIB_PART::deleteAllFields()
 {
     LIB_ITEMS::iterator it;
 
-    for( it = drawings.begin();  it != drawings.end();  /* deleting */  )
+    for( it = GetDrawItemList().begin();  it != GetDrawItemList().end();  /* deleting */  )
     {
         if( it->Type() != LIB_FIELD_T  )
         {
@@ -1230,7 +1279,7 @@ void LIB_PART::deleteAllFields()
         }
 
         // 'it' is not advanced, but should point to next in list after erase()
-        it = drawings.erase( it );
+        it = GetDrawItemList().erase( it );
     }
 }
 
@@ -1245,12 +1294,12 @@ void LIB_PART::SetFields( const std::vector <LIB_FIELD>& aFields )
         LIB_FIELD* field = new LIB_FIELD( aFields[i] );
 
         field->SetParent( this );
-        drawings.push_back( field );
+        GetDrawItemList().push_back( field );
     }
 
     // Reorder drawings: transparent polygons first, pins and text last.
     // so texts have priority on screen.
-    drawings.sort();
+    GetDrawItemList().sort();
 }
 
 
@@ -1274,7 +1323,7 @@ void LIB_PART::GetFields( LIB_FIELDS& aList )
     }
 
     // Now grab all the rest of fields.
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( item.Type() != LIB_FIELD_T )
             continue;
@@ -1291,7 +1340,7 @@ void LIB_PART::GetFields( LIB_FIELDS& aList )
 
 LIB_FIELD* LIB_PART::GetField( int aId )
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( item.Type() != LIB_FIELD_T )
             continue;
@@ -1308,7 +1357,7 @@ LIB_FIELD* LIB_PART::GetField( int aId )
 
 LIB_FIELD* LIB_PART::FindField( const wxString& aFieldName )
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( item.Type() != LIB_FIELD_T )
             continue;
@@ -1380,7 +1429,7 @@ bool LIB_PART::LoadDateAndTime( char* aLine )
 
 void LIB_PART::SetOffset( const wxPoint& aOffset )
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         item.SetOffset( aOffset );
     }
@@ -1389,15 +1438,15 @@ void LIB_PART::SetOffset( const wxPoint& aOffset )
 
 void LIB_PART::RemoveDuplicateDrawItems()
 {
-    drawings.unique();
+    GetDrawItemList().unique();
 }
 
 
 bool LIB_PART::HasConversion() const
 {
-    for( unsigned ii = 0; ii < drawings.size(); ii++  )
+    for( unsigned ii = 0; ii < drawItems().size(); ii++  )
     {
-        const LIB_ITEM& item = drawings[ii];
+        const LIB_ITEM& item = drawItems()[ii];
         if( item.m_Convert > 1 )
             return true;
     }
@@ -1408,7 +1457,7 @@ bool LIB_PART::HasConversion() const
 
 void LIB_PART::ClearStatus()
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         item.m_Flags = 0;
     }
@@ -1419,7 +1468,7 @@ int LIB_PART::SelectItems( EDA_RECT& aRect, int aUnit, int aConvert, bool aEditP
 {
     int itemCount = 0;
 
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         item.ClearFlags( SELECTED );
 
@@ -1448,7 +1497,7 @@ int LIB_PART::SelectItems( EDA_RECT& aRect, int aUnit, int aConvert, bool aEditP
 
 void LIB_PART::MoveSelectedItems( const wxPoint& aOffset )
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( !item.IsSelected() )
             continue;
@@ -1457,13 +1506,13 @@ void LIB_PART::MoveSelectedItems( const wxPoint& aOffset )
         item.m_Flags = 0;
     }
 
-    drawings.sort();
+    GetDrawItemList().sort();
 }
 
 
 void LIB_PART::ClearSelectedItems()
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         item.m_Flags = 0;
     }
@@ -1472,14 +1521,14 @@ void LIB_PART::ClearSelectedItems()
 
 void LIB_PART::DeleteSelectedItems()
 {
-    LIB_ITEMS::iterator item = drawings.begin();
+    LIB_ITEMS::iterator item = GetDrawItemList().begin();
 
     // We *do not* remove the 2 mandatory fields: reference and value
     // so skip them (do not remove) if they are flagged selected.
     // Skip also not visible items.
     // But I think fields must not be deleted by a block delete command or other global command
     // because they are not really graphic items
-    while( item != drawings.end() )
+    while( item != GetDrawItemList().end() )
     {
         if( item->Type() == LIB_FIELD_T )
         {
@@ -1495,7 +1544,7 @@ void LIB_PART::DeleteSelectedItems()
         if( !item->IsSelected() )
             item++;
         else
-            item = drawings.erase( item );
+            item = GetDrawItemList().erase( item );
     }
 }
 
@@ -1507,11 +1556,11 @@ void LIB_PART::CopySelectedItems( const wxPoint& aOffset )
      * When push_back elements in buffer,
      * a memory reallocation can happen and will break pointers
      */
-    unsigned icnt = drawings.size();
+    unsigned icnt = GetDrawItemList().size();
 
     for( unsigned ii = 0; ii < icnt; ii++  )
     {
-        LIB_ITEM& item = drawings[ii];
+        LIB_ITEM& item = GetDrawItemList()[ii];
 
         // We *do not* copy fields because they are unique for the whole component
         // so skip them (do not duplicate) if they are flagged selected.
@@ -1524,18 +1573,18 @@ void LIB_PART::CopySelectedItems( const wxPoint& aOffset )
         item.ClearFlags( SELECTED );
         LIB_ITEM* newItem = (LIB_ITEM*) item.Clone();
         newItem->SetFlags( SELECTED );
-        drawings.push_back( newItem );
+        GetDrawItemList().push_back( newItem );
     }
 
     MoveSelectedItems( aOffset );
-    drawings.sort();
+    GetDrawItemList().sort();
 }
 
 
 
 void LIB_PART::MirrorSelectedItemsH( const wxPoint& aCenter )
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( !item.IsSelected() )
             continue;
@@ -1544,12 +1593,12 @@ void LIB_PART::MirrorSelectedItemsH( const wxPoint& aCenter )
         item.m_Flags = 0;
     }
 
-    drawings.sort();
+    GetDrawItemList().sort();
 }
 
 void LIB_PART::MirrorSelectedItemsV( const wxPoint& aCenter )
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( !item.IsSelected() )
             continue;
@@ -1558,12 +1607,12 @@ void LIB_PART::MirrorSelectedItemsV( const wxPoint& aCenter )
         item.m_Flags = 0;
     }
 
-    drawings.sort();
+    GetDrawItemList().sort();
 }
 
 void LIB_PART::RotateSelectedItems( const wxPoint& aCenter )
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( !item.IsSelected() )
             continue;
@@ -1572,7 +1621,7 @@ void LIB_PART::RotateSelectedItems( const wxPoint& aCenter )
         item.m_Flags = 0;
     }
 
-    drawings.sort();
+    GetDrawItemList().sort();
 }
 
 
@@ -1580,7 +1629,7 @@ void LIB_PART::RotateSelectedItems( const wxPoint& aCenter )
 LIB_ITEM* LIB_PART::LocateDrawItem( int aUnit, int aConvert,
                                     KICAD_T aType, const wxPoint& aPoint )
 {
-    for( LIB_ITEM& item : drawings )
+    for( LIB_ITEM& item : GetDrawItemList() )
     {
         if( ( aUnit && item.m_Unit && ( aUnit != item.m_Unit) )
             || ( aConvert && item.m_Convert && ( aConvert != item.m_Convert ) )
@@ -1624,12 +1673,12 @@ void LIB_PART::SetUnitCount( int aCount )
     if( aCount < m_unitCount )
     {
         LIB_ITEMS::iterator i;
-        i = drawings.begin();
+        i = GetDrawItemList().begin();
 
-        while( i != drawings.end() )
+        while( i != GetDrawItemList().end() )
         {
             if( i->m_Unit > aCount )
-                i = drawings.erase( i );
+                i = GetDrawItemList().erase( i );
             else
                 i++;
         }
@@ -1641,22 +1690,22 @@ void LIB_PART::SetUnitCount( int aCount )
         // We cannot use an iterator here, because when adding items in vector
         // the buffer can be reallocated, that change the previous value of
         // .begin() and .end() iterators and invalidate others iterators
-        unsigned imax = drawings.size();
+        unsigned imax = GetDrawItemList().size();
 
         for( unsigned ii = 0; ii < imax; ii++ )
         {
-            if( drawings[ii].m_Unit != 1 )
+            if( GetDrawItemList()[ii].m_Unit != 1 )
                 continue;
 
             for( int j = prevCount + 1; j <= aCount; j++ )
             {
-                LIB_ITEM* newItem = (LIB_ITEM*) drawings[ii].Clone();
+                LIB_ITEM* newItem = (LIB_ITEM*) GetDrawItemList()[ii].Clone();
                 newItem->m_Unit = j;
-                drawings.push_back( newItem );
+                GetDrawItemList().push_back( newItem );
             }
         }
 
-        drawings.sort();
+        GetDrawItemList().sort();
     }
 
     m_unitCount = aCount;
@@ -1665,6 +1714,8 @@ void LIB_PART::SetUnitCount( int aCount )
 
 void LIB_PART::SetConversion( bool aSetConvert )
 {
+    EnsureDrawItemsParsed();
+
     if( aSetConvert == HasConversion() )
         return;
 
@@ -1673,7 +1724,7 @@ void LIB_PART::SetConversion( bool aSetConvert )
     {
         std::vector< LIB_ITEM* > tmp;     // Temporarily store the duplicated pins here.
 
-        for( LIB_ITEM& item : drawings )
+        for( LIB_ITEM& item : GetDrawItemList() )
         {
             // Only pins are duplicated.
             if( item.Type() != LIB_PIN_T )
@@ -1689,18 +1740,18 @@ void LIB_PART::SetConversion( bool aSetConvert )
 
         // Transfer the new pins to the LIB_PART.
         for( unsigned i = 0;  i < tmp.size();  i++ )
-            drawings.push_back( tmp[i] );
+            GetDrawItemList().push_back( tmp[i] );
     }
     else
     {
         // Delete converted shape items because the converted shape does
         // not exist
-        LIB_ITEMS::iterator i = drawings.begin();
+        LIB_ITEMS::iterator i = GetDrawItemList().begin();
 
-        while( i != drawings.end() )
+        while( i != GetDrawItemList().end() )
         {
             if( i->m_Convert > 1 )
-                i = drawings.erase( i );
+                i = GetDrawItemList().erase( i );
             else
                 i++;
         }
@@ -33,6 +33,7 @@
 #include <general.h>
 #include <lib_draw_item.h>
 #include <lib_field.h>
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -102,12 +103,20 @@ public:
 
     /**
      * Function GetPart
-     * gets the shared LIB_PART.
+     * gets the shared LIB_PART, with its DRAW section parsed
+     * (see LIB_PART::EnsureDrawItemsParsed()).
      *
      * @return LIB_PART* - the LIB_PART shared by
      * this LIB_ALIAS with possibly other LIB_ALIASes.
      */
-    LIB_PART* GetPart() const
+    LIB_PART* GetPart() const;
+
+    /**
+     * Function GetPartHeader
+     * gets the shared LIB_PART without parsing its DRAW section, for the callers which
+     * only read its header (name, units, power flag, aliases) and fields.
+     */
+    LIB_PART* GetPartHeader() const
     {
         return shared;
     }
@@ -197,6 +206,7 @@ class LIB_PART : public EDA_ITEM
     LIBRENTRYOPTIONS    m_options;          ///< Special part features such as POWER or NORMAL.)
     int                 m_unitCount;        ///< Number of units (parts) per package.
     LIB_ITEMS           drawings;           ///< How to draw this part.
+    std::string         m_drawSection;      ///< DRAW section text not parsed into drawings yet.
     wxArrayString       m_FootprintList;    /**< List of suitable footprint names for the
                                                  part (wild card names accepted). */
     LIB_ALIASES         m_aliases;          ///< List of alias object pointers associated with the
@@ -212,6 +222,26 @@ class LIB_PART : public EDA_ITEM
 private:
     void deleteAllFields();
 
+    /**
+     * Read the DRAW section of a part from \a aReader up to its ENDDRAW line, and keep
+     * its text to be parsed by loadDrawSection() when the draw items are first needed.
+     */
+    bool readDrawSection( LINE_READER& aReader, wxString& aErrorMsg );
+
+    /**
+     * Parse the pending DRAW section text into the draw item list.  Parse errors are
+     * reported as warnings, the items read before the error are kept.
+     */
+    void loadDrawSection();
+
+    /// Draw item list of a const part: EnsureDrawItemsParsed() must have been called.
+    const LIB_ITEMS& drawItems() const
+    {
+        wxASSERT_MSG( m_drawSection.empty(),
+                      wxT( "LIB_PART draw items read before EnsureDrawItemsParsed()" ) );
+        return drawings;
+    }
+
     // LIB_PART()  { }     // not legal
 
 public:
@@ -334,6 +364,21 @@ public:
     bool Load( LINE_READER& aReader, wxString& aErrorMsg );
     bool LoadField( LINE_READER& aReader, wxString& aErrorMsg );
     bool LoadDrawEntries( LINE_READER& aReader, wxString& aErrorMsg );
+
+
+    /**
+     * Function EnsureDrawItemsParsed
+     * parses the DRAW section of a part read from a library, if not done yet.
+     * LIB_ALIAS::GetPart() calls it, so a part is parsed before it is used.  The const
+     * members read the draw items as they are.  This is not thread safe: a part must be
+     * parsed before it is shared by several threads.
+     */
+    void EnsureDrawItemsParsed()
+    {
+        if( !m_drawSection.empty() )
+            loadDrawSection();
+    }
+
     bool LoadAliases( char* aLine, wxString& aErrorMsg );
     bool LoadFootprints( LINE_READER& aReader, wxString& aErrorMsg );
 
@@ -646,9 +691,15 @@ public:
     /**
      * Return a reference to the draw item list.
      *
+     * The DRAW section of a part read from a library is only parsed by the first call.
+     *
      * @return LIB_ITEMS& - Reference to the draw item object list.
      */
-    LIB_ITEMS& GetDrawItemList() { return drawings; }
+    LIB_ITEMS& GetDrawItemList()
+    {
+        EnsureDrawItemsParsed();
+        return drawings;
+    }
 
     /**
      * Set the units per part count.
@@ -78,7 +78,7 @@ PART_LIB::~PART_LIB()
     {
         wxLogTrace( traceSchLibMem, wxT( "Removing alias %s from library %s." ),
                     GetChars( it->second->GetName() ), GetChars( GetLogicalName() ) );
-        LIB_PART* part = it->second->GetPart();
+        LIB_PART* part = it->second->GetPartHeader();
         LIB_ALIAS* alias = it->second;
         delete alias;
 
@@ -118,7 +118,7 @@ void PART_LIB::GetEntryTypePowerNames( wxArrayString& aNames, bool aSort, bool a
     for( LIB_ALIAS_MAP::iterator it = m_amap.begin();  it!=m_amap.end();  it++ )
     {
         LIB_ALIAS* alias = it->second;
-        LIB_PART* root = alias->GetPart();
+        LIB_PART* root = alias->GetPartHeader();
 
         if( !root || !root->IsPower() )
             continue;
@@ -266,7 +266,7 @@ bool PART_LIB::HasPowerParts()
     for( LIB_ALIAS_MAP::iterator it = m_amap.begin();  it!=m_amap.end();  it++ )
     {
         LIB_ALIAS* alias = it->second;
-        LIB_PART* root = alias->GetPart();
+        LIB_PART* root = alias->GetPartHeader();
 
         if( root && root->IsPower() )
             return true;
@@ -360,7 +360,7 @@ LIB_ALIAS* PART_LIB::RemoveEntry( LIB_ALIAS* aEntry )
                  aEntry->GetName() + wxT( "> from library <" ) + GetName() + wxT( ">." ) );
 
     LIB_ALIAS*  alias = aEntry;
-    LIB_PART*   part = alias->GetPart();
+    LIB_PART*   part = alias->GetPartHeader();
 
     alias = part->RemoveAlias( alias );
 
@@ -32,6 +32,9 @@
 #define _CLASS_NETLIST_OBJECT_H_
 
 
+#include <map>
+#include <unordered_map>
+
 #include <sch_sheet_path.h>
 #include <lib_pin.h>      // LIB_PIN::PinStringNum( m_PinNum )
 #include <sch_item_struct.h>
@@ -177,6 +180,8 @@ public:
      */
     bool HasNetNameCandidate() { return m_netNameCandidate != NULL; }
 
+    NETLIST_OBJECT* GetNetNameCandidate() const { return m_netNameCandidate; }
+
     /**
      * Function GetPinNum
      * returns a pin number in wxString form.  Pin numbers are not always
@@ -286,6 +291,21 @@ class NETLIST_OBJECT_LIST : public NETLIST_OBJECTS
     int m_lastBusNetCode;   // Used in intermediate calculation:
                             // last net code created for bus members
 
+    // While items are connected, merged net codes are recorded in disjoint set
+    // forests instead of being rewritten in every item: m_netCodeParent[code] is the
+    // code it was merged into (codes outside the vector are not merged).
+    // The net code of an item is the root of the code it holds, see getNet().
+    std::vector<int> m_netCodeParent;
+    std::vector<int> m_busNetCodeParent;
+
+    // Indexes used while items are connected, see buildConnectionIndex()
+    typedef std::unordered_map< size_t, std::vector<unsigned> > INDEX_MAP;
+
+    INDEX_MAP m_itemsByPoint;           // items by their end points (and sheet)
+    INDEX_MAP m_segmentsByLine;         // horizontal and vertical wires and buses
+    std::vector<unsigned> m_otherSegments;                      // all other wires and buses
+    std::map< wxString, std::vector<unsigned> > m_labelsByName; // all items of IsLabelType()
+
 public:
     /**
      * Constructor.
@@ -304,6 +324,14 @@ public:
 
     ~NETLIST_OBJECT_LIST();
 
+    /**
+     * Function Clone
+     * @return NETLIST_OBJECT_LIST* - a new list holding a copy of each item of this list,
+     *         in the same order.  The net name candidates of the copies are the copies
+     *         of the candidates.  Caller owns the list.
+     */
+    NETLIST_OBJECT_LIST* Clone() const;
+
     /**
      * Function BuildNetListInfo
      * the master function of tgis class.
@@ -379,22 +407,18 @@ public:
      */
     void SortListbySheet();
 
-    /**
-     * Counts number of pins connected on the same net.
-     * Used to count all pins connected to a no connect symbol
-     * @return the pin count of the net starting at aNetStart
-     * @param aNetStart = index in list of net objects of the first item
-     */
-    int CountPinsInNet( unsigned aNetStart );
-
     /**
      * Function TestforNonOrphanLabel
      * Sheet labels are expected to be connected to a hierarchical label.
      * Hierarchical labels are expected to be connected to a sheet label.
      * Global labels are expected to be not orphan (connected to at least one other global label.
      * this function tests the connection to an other suitable label
+     * @param aNetItemRef = index in list of the label to test
+     * @param aStartNet = index in list of the first item of the net of the label
+     * @return true if the label is orphan.  The caller reports it, because this function
+     *         can be called for several nets at once.
      */
-    void TestforNonOrphanLabel( unsigned aNetItemRef, unsigned aStartNet );
+    bool TestforNonOrphanLabel( unsigned aNetItemRef, unsigned aStartNet );
 
     /**
      * Function TestforSimilarLabels
@@ -421,10 +445,40 @@ private:
     /*
      * Propagate aNewNetCode to items having an internal netcode aOldNetCode
      * used to interconnect group of items already physically connected,
-     * when a new connection is found between aOldNetCode and aNewNetCode
+     * when a new connection is found between aOldNetCode and aNewNetCode.
+     * Items are not modified, the merge is only recorded in m_netCodeParent
+     * (or m_busNetCodeParent) until resolveNetCodes() is called.
      */
     void propagateNetCode( int aOldNetCode, int aNewNetCode, bool aIsBus );
 
+    /**
+     * Function getNet
+     * @return the net code of aItem, taking into account the codes merged by
+     * propagateNetCode()
+     */
+    int getNet( NETLIST_OBJECT* aItem );
+
+    /**
+     * Function getBusNet
+     * @return the bus net code of aItem, taking into account the codes merged by
+     * propagateNetCode()
+     */
+    int getBusNet( NETLIST_OBJECT* aItem );
+
+    /**
+     * Function resolveNetCodes
+     * stores the final net codes in the items and frees the data used to connect them
+     */
+    void resolveNetCodes();
+
+    /**
+     * Function buildConnectionIndex
+     * indexes the items by end points, by the lines of the wires and buses and
+     * by label name, so the connection functions do not have to scan the whole list.
+     * The list must not be reordered while the index is in use.
+     */
+    void buildConnectionIndex();
+
     /*
      * This function merges the net codes of groups of objects already connected
      * to labels (wires, bus, pins ... ) when 2 labels are equivalents
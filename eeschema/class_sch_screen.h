@@ -554,8 +554,9 @@ public:
     /**
      * Function SchematicCleanUp
      * merges and breaks wire segments in the entire schematic hierarchy.
+     * @return True if any wiring changed.
      */
-    void SchematicCleanUp();
+    bool SchematicCleanUp();
 
     /**
      * Function ReplaceDuplicateTimeStamps
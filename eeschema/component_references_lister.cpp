@@ -31,6 +31,8 @@
 
 #include <wx/regex.h>
 #include <algorithm>
+#include <map>
+#include <tuple>
 #include <vector>
 
 #include <fctsys.h>
@@ -43,6 +45,37 @@
 //#define USE_OLD_ALGO
 
 
+// Indexes of the references being annotated, see SCH_REFERENCE_LIST::Annotate().
+typedef std::map< int, int >                        REF_ID_COUNTS;  // number -> refs using it
+typedef std::pair< std::string, int >               REF_KEY;        // prefix, number
+typedef std::tuple< std::string, wxString, wxString > UNIT_KEY;     // prefix, value, part name
+typedef std::pair< SCH_COMPONENT*, wxString >       INSTANCE_KEY;   // component, sheet path
+
+struct UNIT_CANDIDATES
+{
+    std::vector<unsigned> m_Refs;       // indexes in the list, increasing
+    unsigned              m_First;      // m_Refs before it are annotated or already passed
+
+    UNIT_CANDIDATES() : m_First( 0 ) {}
+};
+
+
+static INSTANCE_KEY instanceKey( const SCH_REFERENCE& aRef )
+{
+    return INSTANCE_KEY( aRef.GetComp(), aRef.GetSheetPath().Path() );
+}
+
+
+// Same as SCH_REFERENCE_LIST::GetRefsInUse(), from the numbers in use for a prefix.
+static void refsInUse( const REF_ID_COUNTS& aIds, std::vector<int>& aIdList, int aMinRefId )
+{
+    aIdList.clear();
+
+    for( REF_ID_COUNTS::const_iterator it = aIds.lower_bound( aMinRefId ); it != aIds.end(); ++it )
+        aIdList.push_back( it->first );
+}
+
+
 void SCH_REFERENCE_LIST::RemoveItem( unsigned int aIndex )
 {
     if( aIndex < componentFlatList.size() )
@@ -254,13 +287,7 @@ int SCH_REFERENCE_LIST::CreateFirstFreeRefId( std::vector<int>& aIdList, int aFi
 
     // We search for expected Id a value >= aFirstValue.
     // Skip existing Id < aFirstValue
-    unsigned ii = 0;
-
-    for( ; ii < aIdList.size(); ii++ )
-    {
-        if( expectedId <= aIdList[ii] )
-            break;
-    }
+    unsigned ii = std::lower_bound( aIdList.begin(), aIdList.end(), expectedId ) - aIdList.begin();
 
     // Ids are sorted by increasing value, from aFirstValue
     // So we search from aFirstValue the first not used value, i.e. the first hole in list.
@@ -295,6 +322,72 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId,
     // Components with an invisible reference (power...) always are re-annotated.
     ResetHiddenReferences();
 
+    // Index the list once, instead of searching the whole list for each component:
+    // the numbers in use for each prefix, the annotated references by prefix and number,
+    // the references which can receive the units of a package in list order, and the
+    // references and locked unit list of each component instance.
+    std::map< std::string, REF_ID_COUNTS >           refIdsInUse;
+    std::map< REF_KEY, std::vector<unsigned> >       refsByNumber;
+    std::map< UNIT_KEY, UNIT_CANDIDATES >            unitCandidates;
+    std::map< INSTANCE_KEY, std::vector<unsigned> >  instances;
+    std::map< INSTANCE_KEY, SCH_REFERENCE_LIST* >    lockedLists;
+
+    auto unitKey = []( const SCH_REFERENCE& aRef )
+    {
+        return UNIT_KEY( aRef.m_Ref, aRef.m_Value->GetText(), aRef.m_RootCmp->GetPartName() );
+    };
+
+    for( unsigned ii = 0; ii < componentFlatList.size(); ii++ )
+    {
+        const SCH_REFERENCE& ref = componentFlatList[ii];
+
+        refIdsInUse[ ref.m_Ref ][ ref.m_NumRef ]++;
+
+        if( !ref.m_IsNew )      // new references are renumbered by setNumRef()
+            refsByNumber[ REF_KEY( ref.m_Ref, ref.m_NumRef ) ].push_back( ii );
+
+        unitCandidates[ unitKey( ref ) ].m_Refs.push_back( ii );
+        instances[ instanceKey( ref ) ].push_back( ii );
+    }
+
+    // The first locked unit list holding an instance is used for it.
+    for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+    {
+        for( unsigned ii = 0; ii < pair.second.GetCount(); ii++ )
+            lockedLists.insert( std::make_pair( instanceKey( pair.second[ii] ), &pair.second ) );
+    }
+
+    // All the reference numbers are changed here to keep the indexes up to date.
+    auto setNumRef = [&]( unsigned aIndex, int aNumRef )
+    {
+        SCH_REFERENCE& ref = componentFlatList[aIndex];
+        REF_ID_COUNTS& ids = refIdsInUse[ ref.m_Ref ];
+
+        if( --ids[ ref.m_NumRef ] == 0 )
+            ids.erase( ref.m_NumRef );
+
+        ids[ aNumRef ]++;
+        refsByNumber[ REF_KEY( ref.m_Ref, aNumRef ) ].push_back( aIndex );
+        ref.m_NumRef = aNumRef;
+    };
+
+    // Same as FindUnit( aIndex, aUnit ) >= 0.
+    auto unitExists = [&]( unsigned aIndex, int aUnit )
+    {
+        const SCH_REFERENCE& ref = componentFlatList[aIndex];
+
+        for( unsigned jj : refsByNumber[ REF_KEY( ref.m_Ref, ref.m_NumRef ) ] )
+        {
+            const SCH_REFERENCE& other = componentFlatList[jj];
+
+            if( jj != aIndex && !other.m_IsNew && other.m_NumRef == ref.m_NumRef
+              && other.m_Unit == aUnit )
+                return true;
+        }
+
+        return false;
+    };
+
     /* calculate index of the first component with the same reference prefix
      * than the current component.  All components having the same reference
      * prefix will receive a reference number with consecutive values:
@@ -321,7 +414,11 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId,
     // This is the list of all Id already in use for a given reference prefix.
     // Will be refilled for each new reference prefix.
     std::vector<int>idList;
-    GetRefsInUse( first, idList, minRefId );
+    refsInUse( refIdsInUse[ componentFlatList[first].m_Ref ], idList, minRefId );
+
+    // The numbers from minRefId to nextFreeId - 1 are in idList: there is no need to
+    // search them again for a free number.
+    int nextFreeId = minRefId;
 #endif
     for( unsigned ii = 0; ii < componentFlatList.size(); ii++ )
     {
@@ -330,20 +427,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId,
 
         // Check whether this component is in aLockedUnitMap.
         SCH_REFERENCE_LIST* lockedList = NULL;
-        for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+
+        if( !lockedLists.empty() )
         {
-            unsigned n_refs = pair.second.GetCount();
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
-            {
-                SCH_REFERENCE &thisRef = pair.second[thisRefI];
+            std::map< INSTANCE_KEY, SCH_REFERENCE_LIST* >::iterator locked =
+                    lockedLists.find( instanceKey( componentFlatList[ii] ) );
 
-                if( thisRef.IsSameInstance( componentFlatList[ii] ) )
-                {
-                    lockedList = &pair.second;
-                    break;
-                }
-            }
-            if( lockedList != NULL ) break;
+            if( locked != lockedLists.end() )
+                lockedList = locked->second;
         }
 
         if(  ( componentFlatList[first].CompareRef( componentFlatList[ii] ) != 0 )
@@ -366,7 +457,8 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId,
             if( aUseSheetNum )
                 minRefId = componentFlatList[ii].m_SheetNum * aSheetIntervalId + 1;
 
-            GetRefsInUse( first, idList, minRefId );
+            refsInUse( refIdsInUse[ componentFlatList[first].m_Ref ], idList, minRefId );
+            nextFreeId = minRefId;
 #endif
         }
 
@@ -378,9 +470,10 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId,
 #ifdef USE_OLD_ALGO
                 LastReferenceNumber++;
 #else
-                LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
+                LastReferenceNumber = CreateFirstFreeRefId( idList, nextFreeId );
+                nextFreeId = LastReferenceNumber + 1;
 #endif
-                componentFlatList[ii].m_NumRef = LastReferenceNumber;
+                setNumRef( ii, LastReferenceNumber );
             }
 
             componentFlatList[ii].m_Unit  = 1;
@@ -397,9 +490,10 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId,
 #ifdef USE_OLD_ALGO
             LastReferenceNumber++;
 #else
-            LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
+            LastReferenceNumber = CreateFirstFreeRefId( idList, nextFreeId );
+            nextFreeId = LastReferenceNumber + 1;
 #endif
-            componentFlatList[ii].m_NumRef = LastReferenceNumber;
+            setNumRef( ii, LastReferenceNumber );
 
             if( !componentFlatList[ii].IsUnitsLocked() )
                 componentFlatList[ii].m_Unit = 1;
@@ -425,14 +519,23 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId,
                 if( thisRef.CompareLibName( componentFlatList[ii] ) != 0 ) continue;
 
                 // Find the matching component
-                for( unsigned jj = ii + 1; jj < componentFlatList.size(); jj++ )
+                std::map< INSTANCE_KEY, std::vector<unsigned> >::iterator instance =
+                        instances.find( instanceKey( thisRef ) );
+
+                if( instance == instances.end() )
+                    continue;
+
+                std::vector<unsigned>::iterator next =
+                        std::upper_bound( instance->second.begin(), instance->second.end(), ii );
+
+                if( next != instance->second.end() )
                 {
-                    if( ! thisRef.IsSameInstance( componentFlatList[jj] ) ) continue;
-                    componentFlatList[jj].m_NumRef = componentFlatList[ii].m_NumRef;
+                    unsigned jj = *next;
+
+                    setNumRef( jj, componentFlatList[ii].m_NumRef );
                     componentFlatList[jj].m_Unit = thisRef.m_Unit;
                     componentFlatList[jj].m_IsNew = false;
                     componentFlatList[jj].m_Flag = 1;
-                    break;
                 }
             }
         }
@@ -443,29 +546,29 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId,
             * we search for others parts that have the same value and the same
             * reference prefix (ref without ref number)
             */
+            UNIT_CANDIDATES& candidates = unitCandidates[ unitKey( componentFlatList[ii] ) ];
+
+            // The candidates up to this component, or already annotated, are never
+            // searched again.
+            while( candidates.m_First < candidates.m_Refs.size()
+                 && ( candidates.m_Refs[candidates.m_First] <= ii
+                    || componentFlatList[ candidates.m_Refs[candidates.m_First] ].m_Flag ) )
+                candidates.m_First++;
+
             for( Unit = 1; Unit <= NumberOfUnits; Unit++ )
             {
                 if( componentFlatList[ii].m_Unit == Unit )
                     continue;
 
-                int found = FindUnit( ii, Unit );
-
-                if( found >= 0 )
+                if( unitExists( ii, Unit ) )
                     continue; // this unit exists for this reference (unit already annotated)
 
                 // Search a component to annotate ( same prefix, same value, not annotated)
-                for( unsigned jj = ii + 1; jj < componentFlatList.size(); jj++ )
+                for( unsigned kk = candidates.m_First; kk < candidates.m_Refs.size(); kk++ )
                 {
-                    if( componentFlatList[jj].m_Flag )    // already tested
-                        continue;
-
-                    if( componentFlatList[ii].CompareRef( componentFlatList[jj] ) != 0 )
-                        continue;
-
-                    if( componentFlatList[jj].CompareValue( componentFlatList[ii] ) != 0 )
-                        continue;
+                    unsigned jj = candidates.m_Refs[kk];
 
-                    if( componentFlatList[jj].CompareLibName( componentFlatList[ii] ) != 0 )
+                    if( componentFlatList[jj].m_Flag )    // already tested
                         continue;
 
                     if( !componentFlatList[jj].m_IsNew )
@@ -475,7 +578,7 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId,
                     if( !componentFlatList[jj].IsUnitsLocked()
                         || ( componentFlatList[jj].m_Unit == Unit ) )
                     {
-                        componentFlatList[jj].m_NumRef = componentFlatList[ii].m_NumRef;
+                        setNumRef( jj, componentFlatList[ii].m_NumRef );
                         componentFlatList[jj].m_Unit   = Unit;
                         componentFlatList[jj].m_Flag   = 1;
                         componentFlatList[jj].m_IsNew  = false;
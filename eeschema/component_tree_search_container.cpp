@@ -24,7 +24,9 @@
 #include <component_tree_search_container.h>
 
 #include <algorithm>
+#include <iterator>
 #include <set>
+#include <string>
 
 #include <wx/string.h>
 #include <wx/tokenzr.h>
@@ -61,7 +63,7 @@ struct COMPONENT_TREE_SEARCH_CONTAINER::TREE_NODE
           DisplayInfo( aDisplayInfo ),
           MatchName( aName.Lower() ),
           SearchText( aSearchText.Lower() ),
-          MatchScore( 0 ), PreviousScore( 0 )
+          MatchScore( 0 ), PreviousScore( 0 ), IndexStamp( 0 )
     {
     }
 
@@ -77,6 +79,7 @@ struct COMPONENT_TREE_SEARCH_CONTAINER::TREE_NODE
 
     unsigned MatchScore;          ///< Result-Score after UpdateSearchTerm()
     unsigned PreviousScore;       ///< Optimization: used to see if we need any tree update.
+    unsigned IndexStamp;          ///< Index stamp of the last search term it may contain.
     wxTreeItemId TreeId;          ///< Tree-ID if stored in the tree (if MatchScore > 0).
 };
 
@@ -103,6 +106,8 @@ COMPONENT_TREE_SEARCH_CONTAINER::COMPONENT_TREE_SEARCH_CONTAINER( PART_LIBS* aLi
     : m_tree( NULL ),
       m_libraries_added( 0 ),
       m_components_added( 0 ),
+      m_indexed_aliases( 0 ),
+      m_index_stamp( 0 ),
       m_preselect_unit_number( -1 ),
       m_libs( aLibs ),
       m_filter( CMP_FILTER_NONE )
@@ -157,6 +162,9 @@ void COMPONENT_TREE_SEARCH_CONTAINER::AddAliasList( const wxString& aNodeName,
                                                aNodeName, wxEmptyString, wxEmptyString );
     m_nodes.push_back( lib_node );
 
+    // The new aliases have no score for the last search term.
+    m_last_search.Clear();
+
     for( const wxString& aName : aAliasNameList )
     {
         LIB_ALIAS* a;
@@ -197,10 +205,11 @@ void COMPONENT_TREE_SEARCH_CONTAINER::AddAliasList( const wxString& aNodeName,
         TREE_NODE* alias_node = new TREE_NODE( TREE_NODE::TYPE_ALIAS, lib_node,
                                                a, a->GetName(), display_info, search_text );
         m_nodes.push_back( alias_node );
+        m_aliases.push_back( alias_node );
 
-        if( a->GetPart()->IsMulti() )    // Add all units as sub-nodes.
+        if( a->GetPartHeader()->IsMulti() )    // Add all units as sub-nodes.
         {
-            for( int u = 1; u <= a->GetPart()->GetUnitCount(); ++u )
+            for( int u = 1; u <= a->GetPartHeader()->GetUnitCount(); ++u )
             {
                 wxString unitName = _("Unit");
                 unitName += wxT( " " ) + LIB_PART::SubReference( u, false );
@@ -254,12 +263,53 @@ static int matchPosScore(int aPosition, int aMaximum)
 }
 
 
+// A plain term has no regular expression or wildcard syntax: the regex, wildcard and
+// substring matchers all find it where a substring search does.
+static bool isPlainTerm( const wxString& aTerm )
+{
+    for( wxString::const_iterator it = aTerm.begin(); it != aTerm.end(); ++it )
+    {
+        wxUniChar c = *it;
+
+        if( !wxIsalnum( c ) && c != '-' && c != '_' )
+            return false;
+    }
+
+    return true;
+}
+
+
+// A search made of plain terms only finds a subset of its results when extended.
+static bool isPlainSearch( const wxString& aSearch )
+{
+    wxStringTokenizer tokenizer( aSearch );
+
+    while( tokenizer.HasMoreTokens() )
+    {
+        if( !isPlainTerm( tokenizer.GetNextToken() ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+static uint64_t trigramKey( const std::wstring& aText, size_t aPos )
+{
+    return ( uint64_t( aText[aPos] & 0x1FFFFF ) << 42 )
+         | ( uint64_t( aText[aPos + 1] & 0x1FFFFF ) << 21 )
+         | uint64_t( aText[aPos + 2] & 0x1FFFFF );
+}
+
+
 namespace
 {
 class EDA_COMBINED_MATCHER
 {
 public:
-    EDA_COMBINED_MATCHER( const wxString &aPattern )
+    EDA_COMBINED_MATCHER( const wxString &aPattern ) :
+        m_pattern( aPattern ),
+        m_plain( isPlainTerm( aPattern ) )
     {
         // Whatever syntax users prefer, it shall be matched.
         AddMatcher( aPattern, new EDA_PATTERN_MATCH_REGEX() );
@@ -281,6 +331,18 @@ public:
      */
     int Find( const wxString &aTerm, int *aMatchersTriggered )
     {
+        if( m_plain )
+        {
+            // All the matchers would find the term here, no need to run the regexes.
+            int loc = aTerm.Find( m_pattern );
+
+            if( loc == wxNOT_FOUND )
+                return EDA_PATTERN_NOT_FOUND;
+
+            *aMatchersTriggered += m_matchers.size();
+            return loc;
+        }
+
         int result = EDA_PATTERN_NOT_FOUND;
 
         for( const EDA_PATTERN_MATCH* matcher : m_matchers )
@@ -301,6 +363,8 @@ public:
         return result;
     }
 
+    bool IsPlain() const { return m_plain; }
+
 private:
     // Add matcher if it can compile the pattern.
     void AddMatcher( const wxString &aPattern, EDA_PATTERN_MATCH *aMatcher )
@@ -316,10 +380,77 @@ private:
     }
 
     std::vector<const EDA_PATTERN_MATCH*> m_matchers;
+    const wxString m_pattern;
+    const bool m_plain;
 };
 }
 
 
+void COMPONENT_TREE_SEARCH_CONTAINER::updateIndex()
+{
+    for( ; m_indexed_aliases < m_aliases.size(); ++m_indexed_aliases )
+    {
+        const TREE_NODE* node = m_aliases[m_indexed_aliases];
+        const std::wstring texts[] = { node->MatchName.ToStdWstring(),
+                                       node->SearchText.ToStdWstring() };
+
+        for( const std::wstring& text : texts )
+        {
+            for( size_t ii = 0; ii + 2 < text.size(); ++ii )
+            {
+                std::vector<unsigned>& aliases = m_trigrams[ trigramKey( text, ii ) ];
+
+                if( aliases.empty() || aliases.back() != m_indexed_aliases )
+                    aliases.push_back( m_indexed_aliases );
+            }
+        }
+    }
+}
+
+
+void COMPONENT_TREE_SEARCH_CONTAINER::markIndexCandidates( const wxString& aTerm )
+{
+    updateIndex();
+
+    ++m_index_stamp;
+
+    const std::wstring term = aTerm.ToStdWstring();
+    std::vector<const std::vector<unsigned>*> lists;
+
+    for( size_t ii = 0; ii + 2 < term.size(); ++ii )
+    {
+        TRIGRAM_INDEX::const_iterator it = m_trigrams.find( trigramKey( term, ii ) );
+
+        if( it == m_trigrams.end() )
+            return;     // no alias contains this trigram
+
+        lists.push_back( &it->second );
+    }
+
+    // Intersect the shortest lists first.
+    std::sort( lists.begin(), lists.end(),
+               []( const std::vector<unsigned>* a, const std::vector<unsigned>* b )
+               {
+                   return a->size() < b->size();
+               } );
+
+    std::vector<unsigned> candidates = *lists[0];
+    std::vector<unsigned> intersection;
+
+    for( size_t ii = 1; ii < lists.size() && !candidates.empty(); ++ii )
+    {
+        intersection.clear();
+        std::set_intersection( candidates.begin(), candidates.end(),
+                               lists[ii]->begin(), lists[ii]->end(),
+                               std::back_inserter( intersection ) );
+        candidates.swap( intersection );
+    }
+
+    for( unsigned idx : candidates )
+        m_aliases[idx]->IndexStamp = m_index_stamp;
+}
+
+
 void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch )
 {
     if( m_tree == NULL )
@@ -332,13 +463,22 @@ void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch
 
     // We score the list by going through it several time, essentially with a complexity
     // of O(n). For the default library of 2000+ items, this typically takes less than 5ms
-    // on an i5. Good enough, no index needed.
+    // on an i5.  With many more libraries, the string searches dominate: plain terms of
+    // 3 characters or more only search the aliases listed by the trigram index, and
+    // typing more characters of a plain search only rescores the remaining results.
+    const bool narrowing = !m_last_search.IsEmpty() && aSearch.StartsWith( m_last_search )
+                           && isPlainSearch( aSearch );
 
     // Initial AND condition: Leaf nodes are considered to match initially.
     for( TREE_NODE* node : m_nodes )
     {
         node->PreviousScore = node->MatchScore;
-        node->MatchScore = ( node->Type == TREE_NODE::TYPE_LIB ) ? 0 : kLowestDefaultScore;
+
+        if( node->Type == TREE_NODE::TYPE_LIB )
+            node->MatchScore = 0;
+        else if( !narrowing || node->MatchScore > 0 )
+            node->MatchScore = kLowestDefaultScore;
+        // else: out of the results of the shorter search, so out of these too.
     }
 
     // Create match scores for each node for all the terms, that come space-separated.
@@ -358,6 +498,10 @@ void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch
     {
         const wxString term = tokenizer.GetNextToken().Lower();
         EDA_COMBINED_MATCHER matcher( term );
+        const bool use_index = matcher.IsPlain() && term.length() >= 3;
+
+        if( use_index )
+            markIndexCandidates( term );
 
         for( TREE_NODE* node : m_nodes )
         {
@@ -373,7 +517,15 @@ void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch
             int found_pos;
             int matcher_fired = 0;
 
-            if( term == node->MatchName )
+            if( use_index && node->IndexStamp != m_index_stamp )
+            {
+                // Neither the name nor the keywords and description contain the term.
+                if( matcher.Find( node->Parent->MatchName, &matcher_fired ) != EDA_PATTERN_NOT_FOUND )
+                    node->MatchScore += 19;
+                else
+                    node->MatchScore = 0;
+            }
+            else if( term == node->MatchName )
                 node->MatchScore += 1000;  // exact match. High score :)
             else if( (found_pos = matcher.Find( node->MatchName, &matcher_fired ) ) != EDA_PATTERN_NOT_FOUND )
             {
@@ -400,6 +552,8 @@ void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch
         }
     }
 
+    m_last_search = aSearch;
+
     // Library nodes have the maximum score seen in any of their children.
     // Alias nodes have the score of their parents.
     unsigned highest_score_seen = 0;
@@ -431,8 +585,13 @@ void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch
     if( !any_change )
         return;
 
-    // Now: sort all items according to match score, libraries first.
-    std::sort( m_nodes.begin(), m_nodes.end(), scoreComparator );
+    // Now: sort all items according to match score, libraries first.  The nodes without
+    // a match are not shown, they are moved to the end unsorted.
+    std::vector<TREE_NODE*>::iterator matches_end =
+            std::partition( m_nodes.begin(), m_nodes.end(),
+                            []( const TREE_NODE* aNode ) { return aNode->MatchScore > 0; } );
+
+    std::sort( m_nodes.begin(), matches_end, scoreComparator );
 
 #ifdef SHOW_CALC_TIME
     unsigned sorttime = GetRunningMicroSecs();
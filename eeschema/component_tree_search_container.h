@@ -25,6 +25,8 @@
 #define COMPONENT_TREE_SEARCH_CONTAINER_H
 
 #include <vector>
+#include <unordered_map>
+#include <stdint.h>
 #include <wx/string.h>
 
 class LIB_ALIAS;
@@ -129,7 +131,31 @@ private:
     struct TREE_NODE;
     static bool scoreComparator( const TREE_NODE* a1, const TREE_NODE* a2 );
 
+    /** Function updateIndex
+     * Add the trigrams of the names and search texts of the aliases added since the
+     * last call to the trigram index.
+     */
+    void updateIndex();
+
+    /** Function markIndexCandidates
+     * Mark with the current index stamp the alias nodes whose name or search text
+     * contain all the trigrams of a plain (no regex or wildcard syntax) search term.
+     * The other aliases cannot contain the term.
+     *
+     * @param aTerm the lowercased search term, at least 3 characters long.
+     */
+    void markIndexCandidates( const wxString& aTerm );
+
+    /// Trigram of lowercased characters -> indexes in m_aliases of the aliases
+    /// containing it, in increasing order.
+    typedef std::unordered_map< uint64_t, std::vector<unsigned> > TRIGRAM_INDEX;
+
     std::vector<TREE_NODE*> m_nodes;
+    std::vector<TREE_NODE*> m_aliases;      // alias nodes, in the order they were added
+    TRIGRAM_INDEX m_trigrams;
+    unsigned m_indexed_aliases;             // count of m_aliases in m_trigrams
+    unsigned m_index_stamp;
+    wxString m_last_search;                 // search term the scores were computed for
     wxTreeCtrl* m_tree;
     int m_libraries_added;
     int m_components_added;
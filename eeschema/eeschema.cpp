@@ -43,6 +43,7 @@
 #include <class_libentry.h>
 #include <hotkeys.h>
 #include <transform.h>
+#include <sch_batch.h>
 #include <wildcards_and_files_ext.h>
 
 #include <kiway.h>
@@ -119,7 +120,14 @@ static struct IFACE : public KIFACE_I
      */
     void* IfaceOrAddress( int aDataId )
     {
-        return NULL;
+        switch( aDataId )
+        {
+        case KIFACE_ADDR_BATCH:
+            return (void*) &SchBatchRun;
+
+        default:
+            return NULL;
+        }
     }
 
 } kiface( "eeschema", KIWAY::FACE_SCH );
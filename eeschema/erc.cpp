@@ -43,6 +43,9 @@
 
 #include <wx/ffile.h>
 
+#include <algorithm>
+#include <map>
+
 
 /* ERC tests :
  *  1 - conflicts between connected pins ( example: 2 connected outputs )
@@ -369,159 +372,317 @@ void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst,
 }
 
 
-void TestOthersItems( NETLIST_OBJECT_LIST* aList,
-                      unsigned aNetItemRef, unsigned aNetStart,
-                      int* aMinConnexion )
+/**
+ * Struct ERC_NET
+ * is a net of a NETLIST_OBJECT_LIST sorted by net code: the items m_Start to m_End - 1
+ * of the list.  The pins of the net are grouped by electrical type, by increasing
+ * index, so a pin is tested against each pin type once instead of against each pin.
+ */
+struct ERC_NET
+{
+    unsigned                m_Start;
+    unsigned                m_End;
+    bool                    m_NoConnect;    ///< a no connect symbol is in the net
+    unsigned                m_PinCount;
+    std::vector<unsigned>   m_Pins[PINTYPE_COUNT];
+};
+
+
+/**
+ * Struct ERC_DIAG
+ * holds the arguments of a Diagnose() call, made once all the nets are tested.
+ */
+struct ERC_DIAG
 {
-    unsigned netItemTst = aNetStart;
-    ELECTRICAL_PINTYPE jj;
+    NETLIST_OBJECT* m_ItemRef;
+    NETLIST_OBJECT* m_ItemTst;
+    int             m_MinConn;
+    int             m_Diag;
+    bool            m_UnconnectedPin;   ///< not reported if a duplicate of the pin is connected
+};
+
+
+/// Pins of the list by pin number and component reference, to find the other
+/// instances of a pin (multiple parts per package and duplicated pins).
+typedef std::map< std::pair<long, wxString>, std::vector<unsigned> > DUPLICATE_PINS;
+
+
+static void addDiag( std::vector<ERC_DIAG>& aDiags, NETLIST_OBJECT* aItemRef,
+                     NETLIST_OBJECT* aItemTst, int aMinConn, int aDiag,
+                     bool aUnconnectedPin = false )
+{
+    ERC_DIAG diag = { aItemRef, aItemTst, aMinConn, aDiag, aUnconnectedPin };
+
+    aDiags.push_back( diag );
+}
+
+
+/**
+ * Function TestOthersItems
+ * performs ERC testing for electrical conflicts between \a aNetItemRef and the other
+ * pins of its net \a aNet, and stores the problems found in \a aDiags.
+ * @param aList = a reference to the list of connected objects
+ * @param aNet = the net of aNetItemRef
+ * @param aNetItemRef = index in list of the current object
+ * @param aMinConnexion = a pointer to a variable to store the minimal connection
+ * found( NOD, DRV, NPI, NET_NC)
+ * @param aDiags = the problems found in aNet
+ */
+static void TestOthersItems( NETLIST_OBJECT_LIST* aList, const ERC_NET& aNet,
+                             unsigned aNetItemRef, int* aMinConnexion,
+                             std::vector<ERC_DIAG>& aDiags )
+{
+    NETLIST_OBJECT* netItemRef = aList->GetItem( aNetItemRef );
+    unsigned erc_item = aNet.m_End;
     int erc = OK;
 
     /* Analysis of the table of connections. */
-    ELECTRICAL_PINTYPE ref_elect_type = aList->GetItem( aNetItemRef )->m_ElectricalPinType;
+    ELECTRICAL_PINTYPE ref_elect_type = netItemRef->m_ElectricalPinType;
     int local_minconn = NOC;
 
     if( ref_elect_type == PIN_NC )
         local_minconn = NPI;
 
+    if( aNet.m_NoConnect )
+        local_minconn = std::max( NET_NC, local_minconn );
+
     /* Test pins connected to NetItemRef */
-    for( ; ; netItemTst++ )
+    for( int jj = 0; jj < PINTYPE_COUNT; jj++ )
     {
-        if( aNetItemRef == netItemTst )
+        const std::vector<unsigned>& pins = aNet.m_Pins[jj];
+
+        // NetItemRef is in the pin list of its own type, but is not tested.
+        if( pins.size() > ( jj == ref_elect_type ? 1U : 0U ) )
+            local_minconn = std::max( MinimalReq[ref_elect_type][jj], local_minconn );
+
+        if( DiagErc[ref_elect_type][jj] == OK )
             continue;
 
-        // We examine only a given net. We stop the search if the net changes
-        if( ( netItemTst >= aList->size() ) // End of list
-            || ( aList->GetItemNet( aNetItemRef ) !=
-                 aList->GetItemNet( netItemTst ) ) ) // End of net
+        // Only the first conflicting pin after NetItemRef is reported.
+        std::vector<unsigned>::const_iterator next =
+                std::upper_bound( pins.begin(), pins.end(), aNetItemRef );
+
+        if( next != pins.end() && *next < erc_item )
         {
-            /* End net code found: minimum connection test. */
-            if( ( *aMinConnexion < NET_NC ) && ( local_minconn < NET_NC ) )
-            {
-                /* Not connected or not driven pin. */
-                bool seterr = true;
+            erc_item = *next;
+            erc = DiagErc[ref_elect_type][jj];
+        }
+    }
 
-                if( local_minconn == NOC &&
-                    aList->GetItemType( aNetItemRef ) == NET_PIN )
-                {
-                    /* This pin is not connected: for multiple part per
-                     * package, and duplicated pin,
-                     * search for an other instance of this pin
-                     * this will be flagged only if all instances of this pin
-                     * are not connected
-                     * TODO test also if instances connected are connected to
-                     * the same net
-                     */
-                    for( unsigned duplicate = 0; duplicate < aList->size(); duplicate++ )
-                    {
-                        if( aList->GetItemType( duplicate ) != NET_PIN )
-                            continue;
-
-                        if( duplicate == aNetItemRef )
-                            continue;
-
-                        if( aList->GetItem( aNetItemRef )->m_PinNum !=
-                            aList->GetItem( duplicate )->m_PinNum )
-                            continue;
-
-                        if( ( (SCH_COMPONENT*) aList->GetItem( aNetItemRef )->
-                             m_Link )->GetRef( &aList->GetItem( aNetItemRef )-> m_SheetPath ) !=
-                            ( (SCH_COMPONENT*) aList->GetItem( duplicate )->m_Link )
-                           ->GetRef( &aList->GetItem( duplicate )->m_SheetPath ) )
-                            continue;
-
-                        // Same component and same pin. Do dot create error for this pin
-                        // if the other pin is connected (i.e. if duplicate net has an other
-                        // item)
-                        if( (duplicate > 0)
-                          && ( aList->GetItemNet( duplicate ) ==
-                               aList->GetItemNet( duplicate - 1 ) ) )
-                            seterr = false;
-
-                        if( (duplicate < aList->size() - 1)
-                          && ( aList->GetItemNet( duplicate ) ==
-                               aList->GetItemNet( duplicate + 1 ) ) )
-                            seterr = false;
-                    }
-                }
+    if( erc != OK && aList->GetConnectionType( erc_item ) == UNCONNECTED )
+    {
+        addDiag( aDiags, netItemRef, aList->GetItem( erc_item ), 0, erc );
+        aList->SetConnectionType( erc_item, NOCONNECT_SYMBOL_PRESENT );
+    }
 
-                if( seterr )
-                    Diagnose( aList->GetItem( aNetItemRef ), NULL, local_minconn, WAR );
+    /* End net code found: minimum connection test. */
+    if( ( *aMinConnexion < NET_NC ) && ( local_minconn < NET_NC ) )
+    {
+        /* Not connected or not driven pin.
+         * If this pin is not connected, it is flagged only if all the other
+         * instances of this pin (multiple parts per package, duplicated pins)
+         * are not connected either: this is known once all the nets are tested.
+         * TODO test also if instances connected are connected to
+         * the same net
+         */
+        addDiag( aDiags, netItemRef, NULL, local_minconn, WAR,
+                 local_minconn == NOC && netItemRef->m_Type == NET_PIN );
+
+        *aMinConnexion = DRV;   // inhibiting other messages of this
+                                // type for the net.
+    }
+}
 
-                *aMinConnexion = DRV;   // inhibiting other messages of this
-                                       // type for the net.
-            }
-            return;
-        }
 
-        switch( aList->GetItemType( netItemTst ) )
+/**
+ * Function testNet
+ * runs the ERC tests of the items of \a aNet and stores the problems found in \a aDiags.
+ * Only the items of aNet are modified, so several nets can be tested at once.
+ */
+static void testNet( NETLIST_OBJECT_LIST* aList, const ERC_NET& aNet,
+                     bool aTestUniqueGlobalLabels, std::vector<ERC_DIAG>& aDiags )
+{
+    int MinConn = NOC;
+
+    for( unsigned itemIdx = aNet.m_Start; itemIdx < aNet.m_End; itemIdx++ )
+    {
+        NETLIST_OBJECT* item = aList->GetItem( itemIdx );
+
+        switch( item->m_Type )
         {
+        // These items do not create erc problems
         case NET_ITEM_UNSPECIFIED:
         case NET_SEGMENT:
         case NET_BUS:
         case NET_JUNCTION:
         case NET_LABEL:
-        case NET_HIERLABEL:
         case NET_BUSLABELMEMBER:
+        case NET_PINLABEL:
+        case NET_GLOBBUSLABELMEMBER:
+            break;
+
+        case NET_HIERLABEL:
         case NET_HIERBUSLABELMEMBER:
-        case NET_SHEETBUSLABELMEMBER:
         case NET_SHEETLABEL:
+        case NET_SHEETBUSLABELMEMBER:
+            // ERC problems when pin sheets do not match hierarchical labels.
+            // Each pin sheet must match a hierarchical label
+            // Each hierarchical label must match a pin sheet
+            if( aList->TestforNonOrphanLabel( itemIdx, aNet.m_Start ) )
+                addDiag( aDiags, item, NULL, -1, WAR );     // Glabel or SheetLabel orphaned.
+            break;
+
         case NET_GLOBLABEL:
-        case NET_GLOBBUSLABELMEMBER:
-        case NET_PINLABEL:
+            if( aTestUniqueGlobalLabels && aList->TestforNonOrphanLabel( itemIdx, aNet.m_Start ) )
+                addDiag( aDiags, item, NULL, -1, WAR );
             break;
 
         case NET_NOCONNECT:
-            local_minconn = std::max( NET_NC, local_minconn );
+
+            // ERC problems when a noconnect symbol is connected to more than one pin.
+            MinConn = NET_NC;
+
+            if( aNet.m_PinCount > 1 )
+                addDiag( aDiags, item, NULL, MinConn, UNC );
+
             break;
 
         case NET_PIN:
-            jj = aList->GetItem( netItemTst )->m_ElectricalPinType;
-            local_minconn = std::max( MinimalReq[ref_elect_type][jj], local_minconn );
 
-            if( netItemTst <= aNetItemRef )
-                break;
+            // Look for ERC problems between pins:
+            TestOthersItems( aList, aNet, itemIdx, &MinConn, aDiags );
+            break;
+        }
+    }
+}
+
 
-            if( erc == OK )
-            {
-                erc = DiagErc[ref_elect_type][jj];
+/**
+ * Function hasConnectedDuplicate
+ * @return true if an other instance of the unconnected pin \a aPin (same pin number
+ *         of the same component reference) is connected to something.
+ * @param aDuplicates = the pins of \a aList, built on the first call.
+ */
+static bool hasConnectedDuplicate( NETLIST_OBJECT_LIST* aList, NETLIST_OBJECT* aPin,
+                                   DUPLICATE_PINS& aDuplicates )
+{
+    if( aDuplicates.empty() )
+    {
+        for( unsigned ii = 0; ii < aList->size(); ii++ )
+        {
+            NETLIST_OBJECT* item = aList->GetItem( ii );
 
-                if( erc != OK )
-                {
-                    if( aList->GetConnectionType( netItemTst ) == UNCONNECTED )
-                    {
-                        Diagnose( aList->GetItem( aNetItemRef ),
-                                  aList->GetItem( netItemTst ),
-                                  0, erc );
-                        aList->SetConnectionType( netItemTst, NOCONNECT_SYMBOL_PRESENT );
-                    }
-                }
-            }
+            if( item->m_Type != NET_PIN )
+                continue;
 
-            break;
+            wxString ref = ( (SCH_COMPONENT*) item->m_Link )->GetRef( &item->m_SheetPath );
+
+            aDuplicates[ std::make_pair( item->m_PinNum, ref ) ].push_back( ii );
         }
     }
+
+    wxString ref = ( (SCH_COMPONENT*) aPin->m_Link )->GetRef( &aPin->m_SheetPath );
+    const std::vector<unsigned>& pins = aDuplicates[ std::make_pair( aPin->m_PinNum, ref ) ];
+
+    for( unsigned ii = 0; ii < pins.size(); ii++ )
+    {
+        unsigned duplicate = pins[ii];
+
+        if( aList->GetItem( duplicate ) == aPin )
+            continue;
+
+        // Same component and same pin. Do dot create error for this pin
+        // if the other pin is connected (i.e. if duplicate net has an other
+        // item)
+        if( (duplicate > 0)
+          && ( aList->GetItemNet( duplicate ) == aList->GetItemNet( duplicate - 1 ) ) )
+            return true;
+
+        if( (duplicate < aList->size() - 1)
+          && ( aList->GetItemNet( duplicate ) == aList->GetItemNet( duplicate + 1 ) ) )
+            return true;
+    }
+
+    return false;
 }
 
-int NETLIST_OBJECT_LIST::CountPinsInNet( unsigned aNetStart )
+
+void TestNetlistErc( NETLIST_OBJECT_LIST* aList, bool aTestSimilarLabels,
+                     bool aTestUniqueGlobalLabels )
 {
-    int count = 0;
-    int curr_net = GetItemNet( aNetStart );
+    // Reset the connection type indicator
+    aList->ResetConnectionsType();
 
-    /* Test pins connected to NetItemRef */
-    for( unsigned item = aNetStart; item < size(); item++ )
+    /* The netlist generated by SCH_EDIT_FRAME::BuildNetListBase is sorted
+     * by net number, which means we can group netlist items into ranges
+     * that live in the same net.  Only the items of a net are compared, so
+     * the nets are tested independently.
+     */
+    std::vector<ERC_NET> nets;
+
+    for( unsigned itemIdx = 0; itemIdx < aList->size(); itemIdx++ )
     {
-        // We examine only a given net. We stop the search if the net changes
-        if( curr_net != GetItemNet( item ) )   // End of net
-            break;
+        NETLIST_OBJECT* item = aList->GetItem( itemIdx );
+
+        if( nets.empty() || aList->GetItemNet( nets.back().m_Start ) != item->GetNet() )
+        {
+            wxASSERT_MSG( nets.empty() || aList->GetItemNet( nets.back().m_Start ) < item->GetNet(),
+                          wxT( "Netlist not correctly ordered" ) );
+
+            // New net found:
+            nets.push_back( ERC_NET() );
+            nets.back().m_Start = itemIdx;
+            nets.back().m_NoConnect = false;
+            nets.back().m_PinCount = 0;
+        }
+
+        ERC_NET& net = nets.back();
+
+        net.m_End = itemIdx + 1;
+
+        if( item->m_Type == NET_NOCONNECT )
+            net.m_NoConnect = true;
+
+        if( item->m_Type == NET_PIN )
+        {
+            net.m_Pins[item->m_ElectricalPinType].push_back( itemIdx );
+            net.m_PinCount++;
+        }
+    }
+
+    // Diagnose() creates the markers in the screens, so it is called after
+    // the nets are tested, in the order of the nets.
+    std::vector< std::vector<ERC_DIAG> > diags( nets.size() );
+
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for( int ii = 0; ii < (int) nets.size(); ii++ )
+        testNet( aList, nets[ii], aTestUniqueGlobalLabels, diags[ii] );
+
+    DUPLICATE_PINS duplicates;
+
+    for( unsigned ii = 0; ii < diags.size(); ii++ )
+    {
+        for( unsigned jj = 0; jj < diags[ii].size(); jj++ )
+        {
+            const ERC_DIAG& diag = diags[ii][jj];
+
+            if( diag.m_UnconnectedPin
+              && hasConnectedDuplicate( aList, diag.m_ItemRef, duplicates ) )
+                continue;
 
-        if( GetItemType( item ) == NET_PIN )
-            count++;
+            Diagnose( diag.m_ItemRef, diag.m_ItemTst, diag.m_MinConn, diag.m_Diag );
+        }
     }
 
-    return count;
+    // Test similar labels (i;e. labels which are identical when
+    // using case insensitive comparisons)
+    if( aTestSimilarLabels )
+        aList->TestforSimilarLabels();
 }
 
+
 bool WriteDiagnosticERC( const wxString& aFullFileName )
 {
     wxString    msg;
@@ -581,10 +742,9 @@ bool WriteDiagnosticERC( const wxString& aFullFileName )
 }
 
 
-void NETLIST_OBJECT_LIST::TestforNonOrphanLabel( unsigned aNetItemRef, unsigned aStartNet )
+bool NETLIST_OBJECT_LIST::TestforNonOrphanLabel( unsigned aNetItemRef, unsigned aStartNet )
 {
     unsigned netItemTst = aStartNet;
-    int      erc = 1;
 
     // Review the list of labels connected to NetItemRef:
     for( ; ; netItemTst++ )
@@ -596,62 +756,27 @@ void NETLIST_OBJECT_LIST::TestforNonOrphanLabel( unsigned aNetItemRef, unsigned
         if( ( netItemTst == size() )
           || ( GetItemNet( aNetItemRef ) != GetItemNet( netItemTst ) ) )
         {
-            /* End Netcode found. */
-            if( erc )
-            {
-                /* Glabel or SheetLabel orphaned. */
-                Diagnose( GetItem( aNetItemRef ), NULL, -1, WAR );
-            }
-
-            return;
+            /* End Netcode found: Glabel or SheetLabel orphaned. */
+            return true;
         }
 
         if( GetItem( aNetItemRef )->IsLabelConnected( GetItem( netItemTst ) ) )
-            erc = 0;
+            return false;
 
         //same thing, different order.
         if( GetItem( netItemTst )->IsLabelConnected( GetItem( aNetItemRef ) ) )
-            erc = 0;
+            return false;
     }
 }
 
 
 // this code try to detect similar labels, i.e. labels which are identical
 // when they are compared using case insensitive coparisons.
+// The labels are bucketed by their lower case text, so only the labels of a
+// bucket are compared.
 
 
-// A helper struct to compare NETLIST_OBJECT items by sheetpath and label texts
-// for a std::set<NETLIST_OBJECT*> container
-// the full text is "sheetpath+label" for local labels and "label" for global labels
-struct compare_labels
-{
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 )
-    {
-        wxString str1 = lab1->m_SheetPath.Path() + lab1->m_Label;
-        wxString str2 = lab2->m_SheetPath.Path() + lab2->m_Label;
-
-        return str1.Cmp( str2 ) < 0;
-    }
-};
-
-struct compare_label_names
-{
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 )
-    {
-        return lab1->m_Label.Cmp( lab2->m_Label ) < 0;
-    }
-};
-
-struct compare_paths
-{
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 )
-    {
-        return lab1->m_SheetPath.Path().Cmp( lab2->m_SheetPath.Path() ) < 0;
-    }
-};
-
-// Helper functions to build the warning messages about Similar Labels:
-static int countIndenticalLabels( std::vector<NETLIST_OBJECT*>& aList, NETLIST_OBJECT* aLabel );
+// Helper function to build the warning messages about Similar Labels:
 static void SimilarLabelsDiagnose( NETLIST_OBJECT* aItemA, NETLIST_OBJECT* aItemB );
 
 
@@ -660,11 +785,16 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
     // Similar labels which are different when using case sensitive comparisons
     // but are equal when using case insensitive comparisons
 
-    // list of all labels (used the better item to build diag messages)
-    std::vector<NETLIST_OBJECT*> fullLabelList;
-    // list of all labels , each label appears only once (used to to detect similar labels)
-    std::set<NETLIST_OBJECT*, compare_labels> uniqueLabelList;
-    wxString msg;
+    // list of all labels, each label appears only once (used to to detect similar labels)
+    // the key is "sheetpath+label" for all labels
+    std::map<wxString, NETLIST_OBJECT*> uniqueLabelList;
+    // sheet path of the labels, Path() is not cheap
+    std::map<NETLIST_OBJECT*, wxString> labelPaths;
+    // count of identical labels (used the better item to build diag messages):
+    //  for global label: global labels in the full project
+    //  for local label: all labels in the current sheet
+    std::map<wxString, int> globalLabelCount;
+    std::map< std::pair<wxString, wxString>, int > sheetLabelCount;
 
     // Build a list of differents labels. If inside a given sheet there are
     // more than one given label, only one label is stored.
@@ -683,10 +813,20 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
         case NET_HIERLABEL:
         case NET_HIERBUSLABELMEMBER:
         case NET_GLOBLABEL:
+        {
             // add this label in lists
-            uniqueLabelList.insert( GetItem( netItem ) );
-            fullLabelList.push_back( GetItem( netItem ) );
+            NETLIST_OBJECT* label = GetItem( netItem );
+            wxString        path = label->m_SheetPath.Path();
+
+            labelPaths[label] = path;
+            uniqueLabelList.insert( std::make_pair( path + label->m_Label, label ) );
+
+            if( label->IsLabelGlobal() )
+                globalLabelCount[label->m_Label]++;
+
+            sheetLabelCount[ std::make_pair( path, label->m_Label ) ]++;
             break;
+        }
 
         case NET_SHEETLABEL:
         case NET_SHEETBUSLABELMEMBER:
@@ -695,118 +835,83 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
         }
     }
 
-    // build global labels and compare
-    std::set<NETLIST_OBJECT*, compare_label_names> loc_labelList;
-    std::set<NETLIST_OBJECT*>::const_iterator it;
-
-    for( it = uniqueLabelList.begin(); it != uniqueLabelList.end(); ++it )
-    {
-        if( (*it)->IsLabelGlobal() )
-            loc_labelList.insert( *it );
-    }
-
-    // compare global labels (same label names appears only once in list)
-    for( it = loc_labelList.begin(); it != loc_labelList.end(); ++it )
+    auto countIdenticalLabels = [&]( NETLIST_OBJECT* aLabel ) -> int
     {
-        std::set<NETLIST_OBJECT*>::const_iterator it_aux = it;
+        if( aLabel->IsLabelGlobal() )
+            return globalLabelCount[aLabel->m_Label];
 
-        for( ++it_aux; it_aux != loc_labelList.end(); ++it_aux )
-        {
-            if( (*it)->m_Label.CmpNoCase( (*it_aux)->m_Label ) == 0 )
-            {
-                // Create new marker for ERC.
-                int cntA = countIndenticalLabels( fullLabelList, *it );
-                int cntB = countIndenticalLabels( fullLabelList, *it_aux );
-
-                if( cntA <= cntB )
-                    SimilarLabelsDiagnose( (*it), (*it_aux) );
-                else
-                    SimilarLabelsDiagnose( (*it_aux), (*it) );
-            }
-        }
-    }
-
-    // Build paths list
-    std::set<NETLIST_OBJECT*, compare_paths> pathsList;
-
-    for( it = uniqueLabelList.begin(); it != uniqueLabelList.end(); ++it )
-        pathsList.insert( *it );
+        return sheetLabelCount[ std::make_pair( labelPaths[aLabel], aLabel->m_Label ) ];
+    };
 
-    // Examine each label inside a sheet path:
-    for( it = pathsList.begin(); it != pathsList.end(); ++it )
+    // Compare the labels of aLabelList, sorted by name (same label names appears only
+    // once in list).  aLocalOnly: at least one label of a pair must be local.
+    auto diagnoseSimilarLabels = [&]( const std::map<wxString, NETLIST_OBJECT*>& aLabelList,
+                                      bool aLocalOnly )
     {
-        loc_labelList.clear();
+        std::vector<NETLIST_OBJECT*> labels;
+        std::map< wxString, std::vector<unsigned> > buckets;
+        std::map<wxString, NETLIST_OBJECT*>::const_iterator it;
 
-        std::set<NETLIST_OBJECT*>::const_iterator it_aux = uniqueLabelList.begin();
-
-        for( ; it_aux != uniqueLabelList.end(); ++it_aux )
+        for( it = aLabelList.begin(); it != aLabelList.end(); ++it )
         {
-            if( (*it)->m_SheetPath.Path() == (*it_aux)->m_SheetPath.Path() )
-                loc_labelList.insert( *it_aux );
+            buckets[it->first.Lower()].push_back( labels.size() );
+            labels.push_back( it->second );
         }
 
-        // at this point, loc_labelList contains labels of the current sheet path.
-        // Detect similar labels (same label names appears only once in list)
-        std::set<NETLIST_OBJECT*>::const_iterator ref_it;
-
-        for( ref_it = loc_labelList.begin(); ref_it != loc_labelList.end(); ++ref_it )
+        for( unsigned ii = 0; ii < labels.size(); ii++ )
         {
-            NETLIST_OBJECT* ref_item = *ref_it;
-            it_aux = ref_it;
+            NETLIST_OBJECT* ref_item = labels[ii];
+            const std::vector<unsigned>& bucket = buckets[ref_item->m_Label.Lower()];
+
+            // the labels of the bucket following ref_item
+            std::vector<unsigned>::const_iterator similar =
+                    std::upper_bound( bucket.begin(), bucket.end(), ii );
 
-            for( ++it_aux; it_aux != loc_labelList.end(); ++it_aux )
+            for( ; similar != bucket.end(); ++similar )
             {
-                // global label versus global label was already examined.
-                // here, at least one label must be local
-                if( ref_item->IsLabelGlobal() && (*it_aux)->IsLabelGlobal() )
+                NETLIST_OBJECT* item = labels[*similar];
+
+                if( aLocalOnly && ref_item->IsLabelGlobal() && item->IsLabelGlobal() )
                     continue;
 
-                if( ref_item->m_Label.CmpNoCase( (*it_aux)->m_Label ) == 0 )
-                {
-                    // Create new marker for ERC.
-                    int cntA = countIndenticalLabels( fullLabelList, ref_item );
-                    int cntB = countIndenticalLabels( fullLabelList, *it_aux );
-
-                    if( cntA <= cntB )
-                        SimilarLabelsDiagnose( ref_item, (*it_aux) );
-                    else
-                        SimilarLabelsDiagnose( (*it_aux), ref_item );
-                }
+                // Create new marker for ERC.
+                int cntA = countIdenticalLabels( ref_item );
+                int cntB = countIdenticalLabels( item );
+
+                if( cntA <= cntB )
+                    SimilarLabelsDiagnose( ref_item, item );
+                else
+                    SimilarLabelsDiagnose( item, ref_item );
             }
         }
-    }
-}
+    };
 
-// Helper function: count the number of labels identical to aLabel
-//  for global label: global labels in the full project
-//  for local label: all labels in the current sheet
-static int countIndenticalLabels( std::vector<NETLIST_OBJECT*>& aList, NETLIST_OBJECT* aLabel )
-{
-    int count = 0;
+    // build global labels and compare
+    std::map<wxString, NETLIST_OBJECT*> loc_labelList;
+    // labels of each sheet path, by name
+    std::map< wxString, std::map<wxString, NETLIST_OBJECT*> > pathsList;
+    std::map<wxString, NETLIST_OBJECT*>::const_iterator it;
 
-    if( aLabel->IsLabelGlobal() )
+    for( it = uniqueLabelList.begin(); it != uniqueLabelList.end(); ++it )
     {
-        for( unsigned netItem = 0; netItem < aList.size(); ++netItem )
-        {
-            NETLIST_OBJECT* item = aList[netItem];
+        NETLIST_OBJECT* label = it->second;
 
-            if( item->IsLabelGlobal() && item->m_Label == aLabel->m_Label )
-                count++;
-        }
-    }
-    else
-    {
-        for( unsigned netItem = 0; netItem < aList.size(); ++netItem )
-        {
-            NETLIST_OBJECT* item = aList[netItem];
+        if( label->IsLabelGlobal() )
+            loc_labelList.insert( std::make_pair( label->m_Label, label ) );
 
-            if( item->m_Label == aLabel->m_Label &&
-                item->m_SheetPath.Path() == aLabel->m_SheetPath.Path() )
-                count++;
-        }
+        pathsList[labelPaths[label]].insert( std::make_pair( label->m_Label, label ) );
     }
 
-    return count;
+    // compare global labels
+    diagnoseSimilarLabels( loc_labelList, false );
+
+    // Examine each label inside a sheet path.
+    // global label versus global label was already examined.
+    // here, at least one label must be local
+    std::map< wxString, std::map<wxString, NETLIST_OBJECT*> >::const_iterator path_it;
+
+    for( path_it = pathsList.begin(); path_it != pathsList.end(); ++path_it )
+        diagnoseSimilarLabels( path_it->second, true );
 }
 
 // Helper function: creates a marker for similar labels ERC warning
@@ -86,17 +86,20 @@ void Diagnose( NETLIST_OBJECT* NetItemRef, NETLIST_OBJECT* NetItemTst,
                       int MinConnexion, int Diag );
 
 /**
- * Perform ERC testing for electrical conflicts between \a NetItemRef and other items
- * (mainly pin) on the same net.
- * @param aList = a reference to the list of connected objects
- * @param aNetItemRef = index in list of the current object
- * @param aNetStart = index in list of net objects of the first item
- * @param aMinConnexion = a pointer to a variable to store the minimal connection
- * found( NOD, DRV, NPI, NET_NC)
+ * Function TestNetlistErc
+ * runs the electrical rules checks on the connected items of \a aList and creates
+ * an ERC marker in the schematic for each problem found.  The nets are tested
+ * independently (in parallel when OpenMP is available) and the markers are created
+ * afterwards, net after net, so their order does not depend on the thread count.
+ * @param aList = the list of connected objects, sorted by net code as
+ *                NETLIST_OBJECT_LIST::BuildNetListInfo() leaves it
+ * @param aTestSimilarLabels = true to flag labels which are identical when using
+ *                             case insensitive comparisons
+ * @param aTestUniqueGlobalLabels = true to flag global labels not connected to
+ *                                  any other global label
  */
-void TestOthersItems( NETLIST_OBJECT_LIST* aList,
-                             unsigned aNetItemRef, unsigned aNetStart,
-                             int* aMinConnexion );
+void TestNetlistErc( NETLIST_OBJECT_LIST* aList, bool aTestSimilarLabels,
+                     bool aTestUniqueGlobalLabels );
 
 /**
  * Function TestDuplicateSheetNames( )
@@ -278,6 +278,7 @@ bool SCH_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
 
     // unload current project file before loading new
     {
+        InvalidateNetListCache();
         delete g_RootSheet;
         g_RootSheet = NULL;
 
@@ -322,6 +323,7 @@ bool SCH_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
     else
     {
 #ifdef USE_SCH_IO_MANAGER
+        InvalidateNetListCache();
         delete g_RootSheet;   // Delete the current project.
         g_RootSheet = NULL;   // Force CreateScreens() to build new empty project on load failure.
 
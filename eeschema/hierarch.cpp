@@ -295,7 +295,8 @@ void SCH_EDIT_FRAME::DisplayCurrentSheet()
         screen->m_FirstRedraw = false;
         SetCrossHairPosition( GetScrollCenterPosition() );
         m_canvas->MoveCursorToCrossHair();
-        screen->SchematicCleanUp();
+        if( screen->SchematicCleanUp() )
+            InvalidateNetListCache();
     }
     else
     {
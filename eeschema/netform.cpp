@@ -43,47 +43,51 @@
 #include <netlist_exporter_kicad.h>
 #include <netlist_exporter_generic.h>
 
-bool SCH_EDIT_FRAME::WriteNetListFile( NETLIST_OBJECT_LIST* aConnectedItemsList,
-                                       int aFormat, const wxString& aFullFileName,
-                                       unsigned aNetlistOptions, REPORTER* aReporter )
+NETLIST_EXPORTER* CreateNetlistExporter( int aFormat, NETLIST_OBJECT_LIST* aMasterList,
+                                         PART_LIBS* aLibs )
 {
-    bool res = true;
-    bool executeCommandLine = false;
-
-    wxString    fileName = aFullFileName;
-
-    NETLIST_EXPORTER *helper;
-
     switch( aFormat )
     {
     case NET_TYPE_PCBNEW:
-        helper = new NETLIST_EXPORTER_KICAD( aConnectedItemsList, Prj().SchLibs() );
-        break;
+        return new NETLIST_EXPORTER_KICAD( aMasterList, aLibs );
 
     case NET_TYPE_ORCADPCB2:
-        helper = new NETLIST_EXPORTER_ORCADPCB2( aConnectedItemsList, Prj().SchLibs() );
-        break;
+        return new NETLIST_EXPORTER_ORCADPCB2( aMasterList, aLibs );
 
     case NET_TYPE_CADSTAR:
-        helper = new NETLIST_EXPORTER_CADSTAR( aConnectedItemsList, Prj().SchLibs() );
-        break;
+        return new NETLIST_EXPORTER_CADSTAR( aMasterList, aLibs );
 
     case NET_TYPE_SPICE:
-        helper = new NETLIST_EXPORTER_PSPICE( aConnectedItemsList, Prj().SchLibs() );
-        break;
+        return new NETLIST_EXPORTER_PSPICE( aMasterList, aLibs );
 
     default:
-        {
-            wxFileName  tmpFile = fileName;
-            tmpFile.SetExt( GENERIC_INTERMEDIATE_NETLIST_EXT );
-            fileName = tmpFile.GetFullPath();
+        return new NETLIST_EXPORTER_GENERIC( aMasterList, aLibs );
+    }
+}
 
-            helper = new NETLIST_EXPORTER_GENERIC( aConnectedItemsList, Prj().SchLibs() );
-            executeCommandLine = true;
-        }
-        break;
+
+bool SCH_EDIT_FRAME::WriteNetListFile( NETLIST_OBJECT_LIST* aConnectedItemsList,
+                                       int aFormat, const wxString& aFullFileName,
+                                       unsigned aNetlistOptions, REPORTER* aReporter )
+{
+    bool res = true;
+    bool executeCommandLine = false;
+
+    wxString    fileName = aFullFileName;
+
+    NETLIST_EXPORTER *helper;
+
+    if( aFormat < NET_TYPE_PCBNEW || aFormat > NET_TYPE_SPICE )
+    {
+        wxFileName  tmpFile = fileName;
+        tmpFile.SetExt( GENERIC_INTERMEDIATE_NETLIST_EXT );
+        fileName = tmpFile.GetFullPath();
+
+        executeCommandLine = true;
     }
 
+    helper = CreateNetlistExporter( aFormat, aConnectedItemsList, Prj().SchLibs() );
+
     res = helper->WriteNetlist( fileName, aNetlistOptions );
     delete helper;
 
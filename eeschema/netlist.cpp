@@ -44,6 +44,7 @@
 #include <sch_text.h>
 #include <sch_sheet.h>
 #include <algorithm>
+#include <functional>
 #include <invoke_sch_dialog.h>
 
 #define IS_WIRE false
@@ -81,7 +82,8 @@ bool SCH_EDIT_FRAME::prepareForNetlist()
     // Cleanup the entire hierarchy
     SCH_SCREENS screens;
 
-    screens.SchematicCleanUp();
+    if( screens.SchematicCleanUp() )
+        InvalidateNetListCache();
 
     return true;
 }
@@ -143,6 +145,36 @@ void NETLIST_OBJECT_LIST::Clear()
 }
 
 
+NETLIST_OBJECT_LIST* NETLIST_OBJECT_LIST::Clone() const
+{
+    std::unique_ptr<NETLIST_OBJECT_LIST> list( new NETLIST_OBJECT_LIST() );
+    std::unordered_map<NETLIST_OBJECT*, NETLIST_OBJECT*> copies;
+
+    list->reserve( size() );
+    list->m_lastNetCode = m_lastNetCode;
+    list->m_lastBusNetCode = m_lastBusNetCode;
+
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        NETLIST_OBJECT* item = new NETLIST_OBJECT( *GetItem( ii ) );
+
+        list->push_back( item );
+        copies[ GetItem( ii ) ] = item;
+    }
+
+    // The net name candidates are items of the list: use the copies.
+    for( unsigned ii = 0; ii < list->size(); ii++ )
+    {
+        NETLIST_OBJECT* item = list->GetItem( ii );
+
+        if( item->HasNetNameCandidate() )
+            item->SetNetNameCandidate( copies[ item->GetNetNameCandidate() ] );
+    }
+
+    return list.release();
+}
+
+
 void NETLIST_OBJECT_LIST::SortListbyNetcode()
 {
     sort( this->begin(), this->end(), NETLIST_OBJECT_LIST::sortItemsbyNetcode );
@@ -157,26 +189,48 @@ void NETLIST_OBJECT_LIST::SortListbySheet()
 
 NETLIST_OBJECT_LIST* SCH_EDIT_FRAME::BuildNetListBase()
 {
-    // I own this list until I return it to the new owner.
-    std::unique_ptr<NETLIST_OBJECT_LIST> ret( new NETLIST_OBJECT_LIST() );
+    PART_LIBS*  libs = Prj().SchLibs();
+    int         libsHash = libs ? libs->GetModifyHash() : 0;
 
-    // Creates the flattened sheet list:
-    SCH_SHEET_LIST aSheets( g_RootSheet );
+    // The connected items are built once, and rebuilt only when the schematic or its
+    // libraries are modified: see InvalidateNetListCache().
+    if( m_netListCache && ( m_netListCacheLibs != libs || m_netListCacheLibsHash != libsHash ) )
+        InvalidateNetListCache();
+
+    if( !m_netListCache )
+    {
+        // Creates the flattened sheet list:
+        SCH_SHEET_LIST aSheets( g_RootSheet );
 
-    // Build netlist info
-    bool success = ret->BuildNetListInfo( aSheets );
+        m_netListCache = new NETLIST_OBJECT_LIST();
+        m_netListCacheLibs = libs;
+        m_netListCacheLibsHash = libsHash;
 
-    if( !success )
+        // Build netlist info
+        m_netListCache->BuildNetListInfo( aSheets );
+    }
+
+    if( m_netListCache->size() == 0 )
     {
         SetStatusText( _( "No Objects" ) );
-        return ret.release();
     }
+    else
+    {
+        wxString msg = wxString::Format( _( "Net count = %d" ), int( m_netListCache->size() ) );
 
-    wxString msg = wxString::Format( _( "Net count = %d" ), int( ret->size() ) );
+        SetStatusText( msg );
+    }
+
+    // The callers own and modify the list they get (connection types, flags),
+    // so they get a copy.
+    return m_netListCache->Clone();
+}
 
-    SetStatusText( msg );
 
-    return ret.release();
+void SCH_EDIT_FRAME::InvalidateNetListCache()
+{
+    delete m_netListCache;
+    m_netListCache = NULL;
 }
 
 
@@ -204,6 +258,8 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     sheet = &(GetItem( 0 )->m_SheetPath);
     m_lastNetCode = m_lastBusNetCode = 1;
 
+    buildConnectionIndex();
+
     for( unsigned ii = 0, istart = 0; ii < size(); ii++ )
     {
         NETLIST_OBJECT* net_item = GetItem( ii );
@@ -224,12 +280,12 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
         case NET_PINLABEL:
         case NET_SHEETLABEL:
         case NET_NOCONNECT:
-            if( net_item->GetNet() != 0 )
+            if( getNet( net_item ) != 0 )
                 break;
 
         case NET_SEGMENT:
             // Test connections point to point type without bus.
-            if( net_item->GetNet() == 0 )
+            if( getNet( net_item ) == 0 )
             {
                 net_item->SetNet( m_lastNetCode );
                 m_lastNetCode++;
@@ -240,7 +296,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
 
         case NET_JUNCTION:
             // Control of the junction outside BUS.
-            if( net_item->GetNet() == 0 )
+            if( getNet( net_item ) == 0 )
             {
                 net_item->SetNet( m_lastNetCode );
                 m_lastNetCode++;
@@ -249,7 +305,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
             segmentToPointConnect( net_item, IS_WIRE, istart );
 
             // Control of the junction, on BUS.
-            if( net_item->m_BusNetCode == 0 )
+            if( getBusNet( net_item ) == 0 )
             {
                 net_item->m_BusNetCode = m_lastBusNetCode;
                 m_lastBusNetCode++;
@@ -262,7 +318,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
         case NET_HIERLABEL:
         case NET_GLOBLABEL:
             // Test connections type junction without bus.
-            if( net_item->GetNet() == 0 )
+            if( getNet( net_item ) == 0 )
             {
                 net_item->SetNet( m_lastNetCode );
                 m_lastNetCode++;
@@ -272,12 +328,12 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
             break;
 
         case NET_SHEETBUSLABELMEMBER:
-            if( net_item->m_BusNetCode != 0 )
+            if( getBusNet( net_item ) != 0 )
                 break;
 
         case NET_BUS:
             // Control type connections point to point mode bus
-            if( net_item->m_BusNetCode == 0 )
+            if( getBusNet( net_item ) == 0 )
             {
                 net_item->m_BusNetCode = m_lastBusNetCode;
                 m_lastBusNetCode++;
@@ -290,7 +346,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
         case NET_HIERBUSLABELMEMBER:
         case NET_GLOBBUSLABELMEMBER:
             // Control connections similar has on BUS
-            if( net_item->GetNet() == 0 )
+            if( getNet( net_item ) == 0 )
             {
                 net_item->m_BusNetCode = m_lastBusNetCode;
                 m_lastBusNetCode++;
@@ -353,6 +409,8 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
             sheetLabelConnect( GetItem( ii ) );
     }
 
+    resolveNetCodes();
+
     // Sort objects by NetCode
     SortListbyNetcode();
 
@@ -385,6 +443,132 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     return true;
 }
 
+// Combine aValue with the hash aSeed
+static inline size_t hashCombine( size_t aSeed, size_t aValue )
+{
+    return aSeed ^ ( aValue + 0x9e3779b9 + ( aSeed << 6 ) + ( aSeed >> 2 ) );
+}
+
+
+// Hash of the sheets of a path; consistent with SCH_SHEET_PATH::operator==()
+static size_t hashSheetPath( const SCH_SHEET_PATH& aPath )
+{
+    size_t hash = aPath.size();
+
+    for( unsigned i = 0; i < aPath.size(); i++ )
+        hash = hashCombine( hash, std::hash<const void*>()( aPath.at( i ) ) );
+
+    return hash;
+}
+
+
+// Keys of the connection index: a point, or a horizontal or vertical line, of a sheet
+enum INDEX_KEY_T
+{
+    KEY_POINT,
+    KEY_HLINE,
+    KEY_VLINE
+};
+
+
+static size_t indexKey( size_t aPathHash, INDEX_KEY_T aType, int aX, int aY = 0 )
+{
+    size_t hash = hashCombine( aPathHash, aType );
+    hash = hashCombine( hash, std::hash<int>()( aX ) );
+    return hashCombine( hash, std::hash<int>()( aY ) );
+}
+
+
+// Find the root of aCode in the disjoint set forest aParents
+static int findNetCode( std::vector<int>& aParents, int aCode )
+{
+    if( aCode < 0 )
+        return aCode;
+
+    while( (unsigned) aCode < aParents.size() && aParents[aCode] != aCode )
+    {
+        // path halving
+        aParents[aCode] = aParents[ aParents[aCode] ];
+        aCode = aParents[aCode];
+    }
+
+    return aCode;
+}
+
+
+int NETLIST_OBJECT_LIST::getNet( NETLIST_OBJECT* aItem )
+{
+    int code = findNetCode( m_netCodeParent, aItem->GetNet() );
+    aItem->SetNet( code );
+
+    return code;
+}
+
+
+int NETLIST_OBJECT_LIST::getBusNet( NETLIST_OBJECT* aItem )
+{
+    aItem->m_BusNetCode = findNetCode( m_busNetCodeParent, aItem->m_BusNetCode );
+
+    return aItem->m_BusNetCode;
+}
+
+
+void NETLIST_OBJECT_LIST::resolveNetCodes()
+{
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        getNet( GetItem( ii ) );
+        getBusNet( GetItem( ii ) );
+    }
+
+    m_netCodeParent.clear();
+    m_busNetCodeParent.clear();
+    m_itemsByPoint.clear();
+    m_segmentsByLine.clear();
+    m_otherSegments.clear();
+    m_labelsByName.clear();
+}
+
+
+void NETLIST_OBJECT_LIST::buildConnectionIndex()
+{
+    m_itemsByPoint.clear();
+    m_segmentsByLine.clear();
+    m_otherSegments.clear();
+    m_labelsByName.clear();
+
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        NETLIST_OBJECT* item = GetItem( ii );
+        size_t pathHash = hashSheetPath( item->m_SheetPath );
+
+        m_itemsByPoint[ indexKey( pathHash, KEY_POINT, item->m_Start.x, item->m_Start.y ) ]
+                .push_back( ii );
+
+        if( item->m_End != item->m_Start )
+        {
+            m_itemsByPoint[ indexKey( pathHash, KEY_POINT, item->m_End.x, item->m_End.y ) ]
+                    .push_back( ii );
+        }
+
+        if( item->m_Type == NET_SEGMENT || item->m_Type == NET_BUS )
+        {
+            // A point is on a horizontal (vertical) segment only if it has the same
+            // y (x) coordinate, see IsPointOnSegment()
+            if( item->m_Start.y == item->m_End.y && item->m_Start.x != item->m_End.x )
+                m_segmentsByLine[ indexKey( pathHash, KEY_HLINE, item->m_Start.y ) ].push_back( ii );
+            else if( item->m_Start.x == item->m_End.x && item->m_Start.y != item->m_End.y )
+                m_segmentsByLine[ indexKey( pathHash, KEY_VLINE, item->m_Start.x ) ].push_back( ii );
+            else
+                m_otherSegments.push_back( ii );
+        }
+
+        if( item->IsLabelType() )
+            m_labelsByName[ item->m_Label ].push_back( ii );
+    }
+}
+
+
 // Helper function to give a priority to sort labels:
 // NET_PINLABEL, NET_GLOBBUSLABELMEMBER and NET_GLOBLABEL are global labels
 // and the priority is high
@@ -602,10 +786,16 @@ void NETLIST_OBJECT_LIST::findBestNetNameForEachNet()
 
 void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel )
 {
-    if( SheetLabel->GetNet() == 0 )
+    if( getNet( SheetLabel ) == 0 )
         return;
 
-    for( unsigned ii = 0; ii < size(); ii++ )
+    std::map< wxString, std::vector<unsigned> >::const_iterator labels;
+    labels = m_labelsByName.find( SheetLabel->m_Label );
+
+    if( labels == m_labelsByName.end() )
+        return;     // no label with the same name
+
+    for( unsigned ii : labels->second )
     {
         NETLIST_OBJECT* ObjetNet = GetItem( ii );
 
@@ -615,17 +805,14 @@ void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel )
         if( (ObjetNet->m_Type != NET_HIERLABEL ) && (ObjetNet->m_Type != NET_HIERBUSLABELMEMBER ) )
             continue;
 
-        if( ObjetNet->GetNet() == SheetLabel->GetNet() )
+        if( getNet( ObjetNet ) == getNet( SheetLabel ) )
             continue;  //already connected.
 
-        if( ObjetNet->m_Label != SheetLabel->m_Label )
-            continue;  //different names.
-
         // Propagate Netcode having all the objects of the same Netcode.
-        if( ObjetNet->GetNet() )
-            propagateNetCode( ObjetNet->GetNet(), SheetLabel->GetNet(), IS_WIRE );
+        if( getNet( ObjetNet ) )
+            propagateNetCode( getNet( ObjetNet ), getNet( SheetLabel ), IS_WIRE );
         else
-            ObjetNet->SetNet( SheetLabel->GetNet() );
+            ObjetNet->SetNet( getNet( SheetLabel ) );
     }
 }
 
@@ -634,39 +821,45 @@ void NETLIST_OBJECT_LIST::connectBusLabels()
 {
     // Propagate the net code between all bus label member objects connected by they name.
     // If the net code is not yet existing, a new one is created
-    // Search is done in the entire list
+    // Search is done in the entire list: the bus label members are grouped by
+    // bus net code and member, which do not change here.
+    std::map< std::pair<int, int>, std::vector<unsigned> > members;
+
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        NETLIST_OBJECT* Label = GetItem( ii );
+
+        if( Label->IsLabelBusMemberType() )
+            members[ std::make_pair( getBusNet( Label ), Label->m_Member ) ].push_back( ii );
+    }
+
     for( unsigned ii = 0; ii < size(); ii++ )
     {
         NETLIST_OBJECT* Label = GetItem( ii );
 
         if( Label->IsLabelBusMemberType() )
         {
-            if( Label->GetNet() == 0 )
+            if( getNet( Label ) == 0 )
             {
                 // Not yet existiing net code: create a new one.
                 Label->SetNet( m_lastNetCode );
                 m_lastNetCode++;
             }
 
-            for( unsigned jj = ii + 1; jj < size(); jj++ )
-            {
-                NETLIST_OBJECT* LabelInTst =  GetItem( jj );
-
-                if( LabelInTst->IsLabelBusMemberType() )
-                {
-                    if( LabelInTst->m_BusNetCode != Label->m_BusNetCode )
-                        continue;
+            const std::vector<unsigned>& group =
+                    members[ std::make_pair( getBusNet( Label ), Label->m_Member ) ];
 
-                    if( LabelInTst->m_Member != Label->m_Member )
-                        continue;
+            for( std::vector<unsigned>::const_iterator jj = std::upper_bound( group.begin(),
+                    group.end(), ii ); jj != group.end(); ++jj )
+            {
+                NETLIST_OBJECT* LabelInTst = GetItem( *jj );
 
-                    if( LabelInTst->GetNet() == 0 )
-                        // Append this object to the current net
-                        LabelInTst->SetNet( Label->GetNet() );
-                    else
-                        // Merge the 2 net codes, they are connected.
-                        propagateNetCode( LabelInTst->GetNet(), Label->GetNet(), IS_WIRE );
-                }
+                if( getNet( LabelInTst ) == 0 )
+                    // Append this object to the current net
+                    LabelInTst->SetNet( getNet( Label ) );
+                else
+                    // Merge the 2 net codes, they are connected.
+                    propagateNetCode( getNet( LabelInTst ), getNet( Label ), IS_WIRE );
             }
         }
     }
@@ -675,121 +868,113 @@ void NETLIST_OBJECT_LIST::connectBusLabels()
 
 void NETLIST_OBJECT_LIST::propagateNetCode( int aOldNetCode, int aNewNetCode, bool aIsBus )
 {
+    std::vector<int>& parents = aIsBus ? m_busNetCodeParent : m_netCodeParent;
+
+    aOldNetCode = findNetCode( parents, aOldNetCode );
+    aNewNetCode = findNetCode( parents, aNewNetCode );
+
     if( aOldNetCode == aNewNetCode )
         return;
 
-    if( aIsBus == false )    // Propagate NetCode
-    {
-        for( unsigned jj = 0; jj < size(); jj++ )
-        {
-            NETLIST_OBJECT* object = GetItem( jj );
+    unsigned needed = std::max( aOldNetCode, aNewNetCode ) + 1;
 
-            if( object->GetNet() == aOldNetCode )
-                object->SetNet( aNewNetCode );
-        }
-    }
-    else               // Propagate BusNetCode
-    {
-        for( unsigned jj = 0; jj < size(); jj++ )
-        {
-            NETLIST_OBJECT* object = GetItem( jj );
+    for( unsigned code = parents.size(); code < needed; code++ )
+        parents.push_back( code );
 
-            if( object->m_BusNetCode == aOldNetCode )
-                object->m_BusNetCode = aNewNetCode;
-        }
-    }
+    // All the items having aOldNetCode now have aNewNetCode
+    parents[aOldNetCode] = aNewNetCode;
 }
 
 
 void NETLIST_OBJECT_LIST::pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus, int start )
 {
-    int netCode;
+    int netCode = aIsBus ? getBusNet( aRef ) : getNet( aRef );
+    size_t pathHash = hashSheetPath( aRef->m_SheetPath );
 
-    if( aIsBus == false )    // Objects other than BUS and BUSLABELS
+    // Only the items having an end point at one of the end points of aRef can be connected
+    for( int ii = 0; ii < 2; ii++ )
     {
-        netCode = aRef->GetNet();
+        if( ii == 1 && aRef->m_End == aRef->m_Start )
+            break;
 
-        for( unsigned i = start; i < size(); i++ )
+        const wxPoint& pt = ii == 0 ? aRef->m_Start : aRef->m_End;
+        INDEX_MAP::const_iterator candidates;
+        candidates = m_itemsByPoint.find( indexKey( pathHash, KEY_POINT, pt.x, pt.y ) );
+
+        if( candidates == m_itemsByPoint.end() )
+            continue;
+
+        for( unsigned i : candidates->second )
         {
+            if( i < (unsigned) start )
+                continue;
+
             NETLIST_OBJECT* item = GetItem( i );
 
             if( item->m_SheetPath != aRef->m_SheetPath )  //used to be > (why?)
                 continue;
 
-            switch( item->m_Type )
+            if( !( aRef->m_Start == item->m_Start
+                   || aRef->m_Start == item->m_End
+                   || aRef->m_End   == item->m_Start
+                   || aRef->m_End   == item->m_End ) )
+                continue;
+
+            if( aIsBus == false )    // Objects other than BUS and BUSLABELS
             {
-            case NET_SEGMENT:
-            case NET_PIN:
-            case NET_LABEL:
-            case NET_HIERLABEL:
-            case NET_GLOBLABEL:
-            case NET_SHEETLABEL:
-            case NET_PINLABEL:
-            case NET_JUNCTION:
-            case NET_NOCONNECT:
-                if( aRef->m_Start == item->m_Start
-                    || aRef->m_Start == item->m_End
-                    || aRef->m_End   == item->m_Start
-                    || aRef->m_End   == item->m_End )
+                switch( item->m_Type )
                 {
-                    if( item->GetNet() == 0 )
+                case NET_SEGMENT:
+                case NET_PIN:
+                case NET_LABEL:
+                case NET_HIERLABEL:
+                case NET_GLOBLABEL:
+                case NET_SHEETLABEL:
+                case NET_PINLABEL:
+                case NET_JUNCTION:
+                case NET_NOCONNECT:
+                    if( getNet( item ) == 0 )
                         item->SetNet( netCode );
                     else
-                        propagateNetCode( item->GetNet(), netCode, IS_WIRE );
+                        propagateNetCode( getNet( item ), netCode, IS_WIRE );
+                    break;
+
+                case NET_BUS:
+                case NET_BUSLABELMEMBER:
+                case NET_SHEETBUSLABELMEMBER:
+                case NET_HIERBUSLABELMEMBER:
+                case NET_GLOBBUSLABELMEMBER:
+                case NET_ITEM_UNSPECIFIED:
+                    break;
                 }
-                break;
-
-            case NET_BUS:
-            case NET_BUSLABELMEMBER:
-            case NET_SHEETBUSLABELMEMBER:
-            case NET_HIERBUSLABELMEMBER:
-            case NET_GLOBBUSLABELMEMBER:
-            case NET_ITEM_UNSPECIFIED:
-                break;
             }
-        }
-    }
-    else    // Object type BUS, BUSLABELS, and junctions.
-    {
-        netCode = aRef->m_BusNetCode;
-
-        for( unsigned i = start; i < size(); i++ )
-        {
-            NETLIST_OBJECT* item = GetItem( i );
-
-            if( item->m_SheetPath != aRef->m_SheetPath )
-                continue;
-
-            switch( item->m_Type )
+            else    // Object type BUS, BUSLABELS, and junctions.
             {
-            case NET_ITEM_UNSPECIFIED:
-            case NET_SEGMENT:
-            case NET_PIN:
-            case NET_LABEL:
-            case NET_HIERLABEL:
-            case NET_GLOBLABEL:
-            case NET_SHEETLABEL:
-            case NET_PINLABEL:
-            case NET_NOCONNECT:
-                break;
-
-            case NET_BUS:
-            case NET_BUSLABELMEMBER:
-            case NET_SHEETBUSLABELMEMBER:
-            case NET_HIERBUSLABELMEMBER:
-            case NET_GLOBBUSLABELMEMBER:
-            case NET_JUNCTION:
-                if(  aRef->m_Start == item->m_Start
-                  || aRef->m_Start == item->m_End
-                  || aRef->m_End   == item->m_Start
-                  || aRef->m_End   == item->m_End )
+                switch( item->m_Type )
                 {
-                    if( item->m_BusNetCode == 0 )
+                case NET_ITEM_UNSPECIFIED:
+                case NET_SEGMENT:
+                case NET_PIN:
+                case NET_LABEL:
+                case NET_HIERLABEL:
+                case NET_GLOBLABEL:
+                case NET_SHEETLABEL:
+                case NET_PINLABEL:
+                case NET_NOCONNECT:
+                    break;
+
+                case NET_BUS:
+                case NET_BUSLABELMEMBER:
+                case NET_SHEETBUSLABELMEMBER:
+                case NET_HIERBUSLABELMEMBER:
+                case NET_GLOBBUSLABELMEMBER:
+                case NET_JUNCTION:
+                    if( getBusNet( item ) == 0 )
                         item->m_BusNetCode = netCode;
                     else
-                        propagateNetCode( item->m_BusNetCode, netCode, IS_BUS );
+                        propagateNetCode( getBusNet( item ), netCode, IS_BUS );
+                    break;
                 }
-                break;
             }
         }
     }
@@ -799,41 +984,68 @@ void NETLIST_OBJECT_LIST::pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus
 void NETLIST_OBJECT_LIST::segmentToPointConnect( NETLIST_OBJECT* aJonction,
                                                  bool aIsBus, int aIdxStart )
 {
-    for( unsigned i = aIdxStart; i < size(); i++ )
-    {
-        NETLIST_OBJECT* segment = GetItem( i );
+    const wxPoint& pt = aJonction->m_Start;
+    size_t pathHash = hashSheetPath( aJonction->m_SheetPath );
+
+    // The segments which can contain the point: the horizontal ones at its y coordinate,
+    // the vertical ones at its x coordinate and all the others
+    const std::vector<unsigned>* candidates[3] = { NULL, NULL, &m_otherSegments };
+    INDEX_MAP::const_iterator line;
+
+    line = m_segmentsByLine.find( indexKey( pathHash, KEY_HLINE, pt.y ) );
 
-        // if different sheets, obviously no physical connection between elements.
-        if( segment->m_SheetPath != aJonction->m_SheetPath )
+    if( line != m_segmentsByLine.end() )
+        candidates[0] = &line->second;
+
+    line = m_segmentsByLine.find( indexKey( pathHash, KEY_VLINE, pt.x ) );
+
+    if( line != m_segmentsByLine.end() )
+        candidates[1] = &line->second;
+
+    for( int jj = 0; jj < 3; jj++ )
+    {
+        if( !candidates[jj] )
             continue;
 
-        if( aIsBus == IS_WIRE )
+        for( unsigned i : *candidates[jj] )
         {
-            if( segment->m_Type != NET_SEGMENT )
+            if( i < (unsigned) aIdxStart )
                 continue;
-        }
-        else
-        {
-            if( segment->m_Type != NET_BUS )
+
+            NETLIST_OBJECT* segment = GetItem( i );
+
+            // if different sheets, obviously no physical connection between elements.
+            if( segment->m_SheetPath != aJonction->m_SheetPath )
                 continue;
-        }
 
-        if( IsPointOnSegment( segment->m_Start, segment->m_End, aJonction->m_Start ) )
-        {
-            // Propagation Netcode has all the objects of the same Netcode.
             if( aIsBus == IS_WIRE )
             {
-                if( segment->GetNet() )
-                    propagateNetCode( segment->GetNet(), aJonction->GetNet(), aIsBus );
-                else
-                    segment->SetNet( aJonction->GetNet() );
+                if( segment->m_Type != NET_SEGMENT )
+                    continue;
             }
             else
             {
-                if( segment->m_BusNetCode )
-                    propagateNetCode( segment->m_BusNetCode, aJonction->m_BusNetCode, aIsBus );
+                if( segment->m_Type != NET_BUS )
+                    continue;
+            }
+
+            if( IsPointOnSegment( segment->m_Start, segment->m_End, aJonction->m_Start ) )
+            {
+                // Propagation Netcode has all the objects of the same Netcode.
+                if( aIsBus == IS_WIRE )
+                {
+                    if( getNet( segment ) )
+                        propagateNetCode( getNet( segment ), getNet( aJonction ), aIsBus );
+                    else
+                        segment->SetNet( getNet( aJonction ) );
+                }
                 else
-                    segment->m_BusNetCode = aJonction->m_BusNetCode;
+                {
+                    if( getBusNet( segment ) )
+                        propagateNetCode( getBusNet( segment ), getBusNet( aJonction ), aIsBus );
+                    else
+                        segment->m_BusNetCode = getBusNet( aJonction );
+                }
             }
         }
     }
@@ -842,14 +1054,25 @@ void NETLIST_OBJECT_LIST::segmentToPointConnect( NETLIST_OBJECT* aJonction,
 
 void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef )
 {
-    if( aLabelRef->GetNet() == 0 )
+    if( getNet( aLabelRef ) == 0 )
+        return;
+
+    // NET_HIERLABEL are used to connect sheets.
+    // NET_LABEL are local to a sheet
+    // NET_GLOBLABEL are global.
+    // NET_PINLABEL is a kind of global label (generated by a power pin invisible)
+    // Only labels having the same name can be connected.
+    std::map< wxString, std::vector<unsigned> >::const_iterator labels;
+    labels = m_labelsByName.find( aLabelRef->m_Label );
+
+    if( labels == m_labelsByName.end() )
         return;
 
-    for( unsigned i = 0; i < size(); i++ )
+    for( unsigned i : labels->second )
     {
         NETLIST_OBJECT* item = GetItem( i );
 
-        if( item->GetNet() == aLabelRef->GetNet() )
+        if( getNet( item ) == getNet( aLabelRef ) )
             continue;
 
         if( item->m_SheetPath != aLabelRef->m_SheetPath )
@@ -865,20 +1088,10 @@ void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef )
                 continue;
         }
 
-        // NET_HIERLABEL are used to connect sheets.
-        // NET_LABEL are local to a sheet
-        // NET_GLOBLABEL are global.
-        // NET_PINLABEL is a kind of global label (generated by a power pin invisible)
-        if( item->IsLabelType() )
-        {
-            if( item->m_Label != aLabelRef->m_Label )
-                continue;
-
-            if( item->GetNet() )
-                propagateNetCode( item->GetNet(), aLabelRef->GetNet(), IS_WIRE );
-            else
-                item->SetNet( aLabelRef->GetNet() );
-        }
+        if( getNet( item ) )
+            propagateNetCode( getNet( item ), getNet( aLabelRef ), IS_WIRE );
+        else
+            item->SetNet( getNet( aLabelRef ) );
     }
 }
 
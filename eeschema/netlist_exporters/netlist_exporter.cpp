@@ -234,24 +234,57 @@ SCH_COMPONENT* NETLIST_EXPORTER::findNextComponentAndCreatePinList( EDA_ITEM*
     return NULL;
 }
 
-bool NETLIST_EXPORTER::addPinToComponentPinList( SCH_COMPONENT* aComponent,
-                                      SCH_SHEET_PATH* aSheetPath, LIB_PIN* aPin )
+void NETLIST_EXPORTER::buildComponentIndex()
 {
-    // Search the PIN description for Pin in g_NetObjectslist
+    if( m_componentIndexBuilt )
+        return;
+
+    m_componentIndexBuilt = true;
+
     for( unsigned ii = 0; ii < m_masterList->size(); ii++ )
     {
         NETLIST_OBJECT* pin = m_masterList->GetItem( ii );
 
-        if( pin->m_Type != NET_PIN )
-            continue;
+        if( pin->m_Type == NET_PIN )
+            m_componentPins[ std::make_pair( pin->m_Link, pin->m_PinNum ) ].push_back( pin );
+    }
 
-        if( pin->m_Link != aComponent )
-            continue;
+    m_sheetList = SCH_SHEET_LIST( g_RootSheet );
+
+    for( unsigned i = 0;  i < m_sheetList.size();  i++ )
+    {
+        for( EDA_ITEM* item = m_sheetList[i].LastDrawList();  item;  item = item->Next() )
+        {
+            if( item->Type() != SCH_COMPONENT_T )
+                continue;
+
+            SCH_COMPONENT*  comp = (SCH_COMPONENT*) item;
+            wxString        ref = comp->GetRef( &m_sheetList[i] ).Lower();
+
+            m_componentInstances[ref].push_back( std::make_pair( comp, i ) );
+        }
+    }
+}
 
-        if( pin->m_PinNum != aPin->GetNumber() )
-            continue;
 
-        // most expensive test at the end.
+bool NETLIST_EXPORTER::addPinToComponentPinList( SCH_COMPONENT* aComponent,
+                                      SCH_SHEET_PATH* aSheetPath, LIB_PIN* aPin )
+{
+    buildComponentIndex();
+
+    // Search the PIN description for Pin in g_NetObjectslist
+    std::map< std::pair<SCH_ITEM*, long>, NETLIST_OBJECTS >::const_iterator it =
+            m_componentPins.find( std::make_pair( (SCH_ITEM*) aComponent, aPin->GetNumber() ) );
+
+    if( it == m_componentPins.end() )
+        return false;
+
+    const NETLIST_OBJECTS& pins = it->second;
+
+    for( unsigned ii = 0; ii < pins.size(); ii++ )
+    {
+        NETLIST_OBJECT* pin = pins[ii];
+
         if( pin->m_SheetPath != *aSheetPath )
             continue;
 
@@ -325,41 +358,31 @@ void NETLIST_EXPORTER::findAllInstancesOfComponent( SCH_COMPONENT*  aComponent,
                                          LIB_PART*       aEntry,
                                          SCH_SHEET_PATH* aSheetPath )
 {
-    wxString    ref = aComponent->GetRef( aSheetPath );
-    wxString    ref2;
+    buildComponentIndex();
 
-    SCH_SHEET_LIST sheetList( g_RootSheet );
+    // The references are compared case insensitively.
+    const std::vector< std::pair<SCH_COMPONENT*, unsigned> >& instances =
+            m_componentInstances[ aComponent->GetRef( aSheetPath ).Lower() ];
 
-    for( unsigned i = 0;  i < sheetList.size();  i++ )
+    for( unsigned i = 0;  i < instances.size();  i++ )
     {
-        for( EDA_ITEM* item = sheetList[i].LastDrawList();  item;  item = item->Next() )
-        {
-            if( item->Type() != SCH_COMPONENT_T )
-                continue;
+        SCH_COMPONENT*  comp2 = instances[i].first;
+        SCH_SHEET_PATH* sheet2 = &m_sheetList[ instances[i].second ];
 
-            SCH_COMPONENT*  comp2 = (SCH_COMPONENT*) item;
+        int unit2 = comp2->GetUnitSelection( sheet2 );  // slow
 
-            ref2 = comp2->GetRef( &sheetList[i] );
+        for( LIB_PIN* pin = aEntry->GetNextPin();  pin;  pin = aEntry->GetNextPin( pin ) )
+        {
+            wxASSERT( pin->Type() == LIB_PIN_T );
 
-            if( ref2.CmpNoCase( ref ) != 0 )
+            if( pin->GetUnit() && pin->GetUnit() != unit2 )
                 continue;
 
-            int unit2 = comp2->GetUnitSelection( &sheetList[i] );  // slow
-
-            for( LIB_PIN* pin = aEntry->GetNextPin();  pin;  pin = aEntry->GetNextPin( pin ) )
-            {
-                wxASSERT( pin->Type() == LIB_PIN_T );
-
-                if( pin->GetUnit() && pin->GetUnit() != unit2 )
-                    continue;
-
-                if( pin->GetConvert() && pin->GetConvert() != comp2->GetConvert() )
-                    continue;
+            if( pin->GetConvert() && pin->GetConvert() != comp2->GetConvert() )
+                continue;
 
-                // A suitable pin is found: add it to the current list
-                addPinToComponentPinList( comp2, &sheetList[i], pin );
-            }
+            // A suitable pin is found: add it to the current list
+            addPinToComponentPinList( comp2, sheet2, pin );
         }
     }
 }
-
@@ -26,6 +26,8 @@
 #ifndef NETLIST_EXPORTER_H
 #define NETLIST_EXPORTER_H
 
+#include <map>
+
 #include <kicad_string.h>
 
 #include <class_libentry.h>
@@ -106,6 +108,30 @@ protected:
     // share a code generated std::set<void*> to reduce code volume
     std::set<void*>     m_Libraries;    ///< unique libraries used
 
+    /// The component model shared by the pin list builders, made once from
+    /// m_masterList and the schematic by buildComponentIndex().  It points to the
+    /// items of m_masterList, which each exporter deletes and flags (m_Flag) while
+    /// writing, so it is not shared between exporters:
+    bool                m_componentIndexBuilt;
+
+    /// pins of m_masterList by component and pin number, in list order.
+    std::map< std::pair<SCH_ITEM*, long>, NETLIST_OBJECTS > m_componentPins;
+
+    /// sheets of the schematic.
+    SCH_SHEET_LIST      m_sheetList;
+
+    /// components of the schematic by lower case reference, in sheet order, with
+    /// the index of their sheet in m_sheetList.
+    std::map< wxString, std::vector< std::pair<SCH_COMPONENT*, unsigned> > > m_componentInstances;
+
+    /**
+     * Function buildComponentIndex
+     * fills m_componentPins, m_sheetList and m_componentInstances, if not already done.
+     * A pin or a component instance is then found without scanning the whole master
+     * list or the whole schematic.
+     */
+    void buildComponentIndex();
+
     /**
      * Function sprintPinNetName
      * formats the net name for \a aPin using \a aNetNameFormat into \a aResult.
@@ -176,7 +202,8 @@ public:
      */
     NETLIST_EXPORTER( NETLIST_OBJECT_LIST* aMasterList, PART_LIBS* aLibs ) :
         m_masterList( aMasterList ),
-        m_libs( aLibs )
+        m_libs( aLibs ),
+        m_componentIndexBuilt( false )
     {
     }
 
@@ -232,4 +259,16 @@ public:
             );
 };
 
+
+/**
+ * Function CreateNetlistExporter
+ * returns a new exporter writing the netlist format \a aFormat (a NETLIST_TYPE_ID).
+ * User defined formats get the generic (intermediate) exporter, whose output is
+ * then converted by the user's command.
+ * @param aMasterList the exporter takes ownership of this list.
+ * @param aLibs the component libraries of the project.
+ */
+NETLIST_EXPORTER* CreateNetlistExporter( int aFormat, NETLIST_OBJECT_LIST* aMasterList,
+                                         PART_LIBS* aLibs );
+
 #endif
@@ -0,0 +1,301 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2016 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file sch_batch.cpp
+ */
+
+#include <fctsys.h>
+#include <common.h>
+#include <macros.h>
+#include <kiway.h>
+#include <project.h>
+#include <reporter.h>
+#include <wildcards_and_files_ext.h>
+
+#include <general.h>
+#include <class_library.h>
+#include <class_sch_screen.h>
+#include <sch_io_mgr.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+#include <sch_marker.h>
+#include <sch_reference_list.h>
+#include <class_netlist_object.h>
+#include <netlist.h>
+#include <netlist_exporter.h>
+#include <erc.h>
+#include <sch_batch.h>
+
+#include <memory>
+
+
+/// Netlist format names accepted by "--format"
+static const struct
+{
+    const char* name;
+    int         format;
+} netlistFormats[] =
+{
+    { "kicad",      NET_TYPE_PCBNEW },
+    { "orcadpcb2",  NET_TYPE_ORCADPCB2 },
+    { "cadstar",    NET_TYPE_CADSTAR },
+    { "spice",      NET_TYPE_SPICE },
+    { "generic",    NET_TYPE_CUSTOM1 },     // the intermediate XML netlist
+};
+
+
+/**
+ * Function reportTime
+ * reports the time spent in \a aStep since \a aStart, and restarts \a aStart.
+ */
+static void reportTime( REPORTER& aReporter, const wxString& aStep, unsigned& aStart )
+{
+    unsigned now = GetRunningMicroSecs();
+
+    aReporter.Report( wxString::Format( wxT( "%s: %.1f ms" ), GetChars( aStep ),
+                                        ( now - aStart ) / 1000.0 ),
+                      REPORTER::RPT_INFO );
+    aStart = now;
+}
+
+
+SCH_BATCH_OPTIONS::SCH_BATCH_OPTIONS() :
+    m_NetlistFormat( NET_TYPE_PCBNEW ),
+    m_NetlistOptions( 0 ),
+    m_RunErc( false ),
+    m_TestSimilarLabels( true ),
+    m_TestUniqueGlobalLabels( true )
+{
+}
+
+
+int SchBatchNetlist( KIWAY* aKiway, const SCH_BATCH_OPTIONS& aOptions, REPORTER& aReporter )
+{
+    PROJECT&    prj = aKiway->Prj();
+    wxFileName  fn = aOptions.m_SchematicFile;
+    wxString    msg;
+    unsigned    start = GetRunningMicroSecs();
+    unsigned    step = start;
+
+    fn.MakeAbsolute();
+
+    wxFileName  pro = fn;
+    pro.SetExt( ProjectFileExtension );
+
+    prj.SetProjectFullName( pro.GetFullPath() );
+
+    // The libraries must be loaded before the schematic, whose components are linked
+    // to their parts while loading.  PROJECT::SchLibs() cannot be used here because
+    // it reports missing libraries in a dialog.
+    PART_LIBS* libs = new PART_LIBS();
+
+    prj.SetElem( PROJECT::ELEM_SCH_PART_LIBS, libs );     // PROJECT owns it
+
+    try
+    {
+        libs->LoadAllLibraries( &prj );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        aReporter.Report( ioe.errorText, REPORTER::RPT_WARNING );
+    }
+
+    reportTime( aReporter, _( "Load libraries" ), step );
+
+    delete g_RootSheet;
+    g_RootSheet = NULL;
+
+    try
+    {
+        g_RootSheet = SCH_IO_MGR::Load( SCH_IO_MGR::SCH_LEGACY, fn.GetFullPath(), aKiway );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        msg.Printf( _( "Error loading schematic file '%s'.\n%s" ),
+                    GetChars( fn.GetFullPath() ), GetChars( ioe.errorText ) );
+        aReporter.Report( msg, REPORTER::RPT_ERROR );
+        return -1;
+    }
+
+    reportTime( aReporter, _( "Load schematic" ), step );
+
+    SCH_SHEET_LIST      sheets( g_RootSheet );
+    SCH_REFERENCE_LIST  components;
+    wxArrayString       messages;
+
+    sheets.AnnotatePowerSymbols( libs );
+    sheets.GetComponents( libs, components );
+
+    if( components.CheckAnnotation( &messages ) )
+    {
+        for( unsigned ii = 0; ii < messages.GetCount(); ii++ )
+            aReporter.Report( messages[ii], REPORTER::RPT_ERROR );
+
+        aReporter.Report( _( "Exporting the netlist requires a completely annotated schematic." ),
+                          REPORTER::RPT_ERROR );
+        return -1;
+    }
+
+    SCH_SCREENS screens;
+
+    screens.SchematicCleanUp();
+    screens.DeleteAllMarkers( MARKER_BASE::MARKER_ERC );
+
+    if( TestDuplicateSheetNames( aOptions.m_RunErc ) > 0 )
+        aReporter.Report( _( "Error: duplicate sheet names." ), REPORTER::RPT_WARNING );
+
+    // The exporter owns the list.  The netlist is written before running the ERC
+    // because the ERC resets the pin connection state the exporters read.
+    NETLIST_OBJECT_LIST*                items = new NETLIST_OBJECT_LIST();
+    std::unique_ptr<NETLIST_EXPORTER>   exporter(
+            CreateNetlistExporter( aOptions.m_NetlistFormat, items, libs ) );
+
+    if( !items->BuildNetListInfo( sheets ) )
+        aReporter.Report( _( "No Objects" ), REPORTER::RPT_WARNING );
+
+    msg.Printf( _( "Net count = %d" ), int( items->size() ) );
+    aReporter.Report( msg, REPORTER::RPT_INFO );
+
+    reportTime( aReporter, _( "Build connections" ), step );
+
+    if( !aOptions.m_NetlistFile.IsEmpty() )
+    {
+        if( !exporter->WriteNetlist( aOptions.m_NetlistFile, aOptions.m_NetlistOptions ) )
+        {
+            msg.Printf( _( "Failed to create file '%s'." ), GetChars( aOptions.m_NetlistFile ) );
+            aReporter.Report( msg, REPORTER::RPT_ERROR );
+            return -1;
+        }
+
+        reportTime( aReporter, _( "Write netlist" ), step );
+    }
+
+    int errors = 0;
+
+    if( aOptions.m_RunErc )
+    {
+        TestNetlistErc( items, aOptions.m_TestSimilarLabels, aOptions.m_TestUniqueGlobalLabels );
+
+        errors = screens.GetMarkerCount( MARKER_BASE::MARKER_ERC,
+                                         MARKER_BASE::MARKER_SEVERITY_ERROR );
+        int warnings = screens.GetMarkerCount( MARKER_BASE::MARKER_ERC,
+                                               MARKER_BASE::MARKER_SEVERITY_WARNING );
+
+        msg.Printf( _( "ERC messages: %d  Errors %d  Warnings %d" ),
+                    screens.GetMarkerCount( MARKER_BASE::MARKER_ERC,
+                                            MARKER_BASE::MARKER_SEVERITY_UNSPEC ),
+                    errors, warnings );
+        aReporter.Report( msg, errors ? REPORTER::RPT_ERROR : REPORTER::RPT_INFO );
+
+        if( !aOptions.m_ErcFile.IsEmpty() && !WriteDiagnosticERC( aOptions.m_ErcFile ) )
+        {
+            msg.Printf( _( "Failed to create file '%s'." ), GetChars( aOptions.m_ErcFile ) );
+            aReporter.Report( msg, REPORTER::RPT_ERROR );
+            return -1;
+        }
+
+        reportTime( aReporter, _( "ERC" ), step );
+    }
+
+    reportTime( aReporter, _( "Total" ), start );
+
+    return errors;
+}
+
+
+int SchBatchRun( KIWAY* aKiway, const std::vector<wxString>& aArgs )
+{
+    SCH_BATCH_OPTIONS   options;
+    CONSOLE_REPORTER    reporter;
+    wxString            msg;
+
+    for( unsigned ii = 0; ii < aArgs.size(); ii++ )
+    {
+        const wxString& arg = aArgs[ii];
+        bool            hasValue = ii + 1 < aArgs.size();
+
+        if( arg == wxT( "--netlist" ) && hasValue )
+            options.m_NetlistFile = aArgs[++ii];
+        else if( arg == wxT( "--format" ) && hasValue )
+        {
+            wxString name = aArgs[++ii];
+
+            options.m_NetlistFormat = NET_TYPE_UNINIT;
+
+            for( unsigned jj = 0; jj < DIM( netlistFormats ); jj++ )
+            {
+                if( name == FROM_UTF8( netlistFormats[jj].name ) )
+                    options.m_NetlistFormat = netlistFormats[jj].format;
+            }
+
+            if( options.m_NetlistFormat == NET_TYPE_UNINIT )
+            {
+                msg.Printf( _( "Unknown netlist format '%s'" ), GetChars( name ) );
+                reporter.Report( msg, REPORTER::RPT_ERROR );
+                return 2;
+            }
+        }
+        else if( arg == wxT( "--spice-x-prefix" ) )
+            options.m_NetlistOptions |= NET_USE_X_PREFIX;
+        else if( arg == wxT( "--spice-net-numbers" ) )
+            options.m_NetlistOptions |= NET_USE_NETCODES_AS_NETNAMES;
+        else if( arg == wxT( "--erc" ) )
+            options.m_RunErc = true;
+        else if( arg == wxT( "--erc-report" ) && hasValue )
+        {
+            options.m_RunErc = true;
+            options.m_ErcFile = aArgs[++ii];
+        }
+        else if( arg == wxT( "--no-similar-labels" ) )
+            options.m_TestSimilarLabels = false;
+        else if( arg == wxT( "--no-unique-global-labels" ) )
+            options.m_TestUniqueGlobalLabels = false;
+        else if( !arg.StartsWith( wxT( "--" ) ) && options.m_SchematicFile.IsEmpty() )
+            options.m_SchematicFile = arg;
+        else
+        {
+            msg.Printf( _( "Invalid argument '%s'" ), GetChars( arg ) );
+            reporter.Report( msg, REPORTER::RPT_ERROR );
+            return 2;
+        }
+    }
+
+    if( options.m_SchematicFile.IsEmpty() )
+    {
+        reporter.Report( wxT( "usage: eeschema --batch file.sch [--netlist file]"
+                              " [--format kicad|orcadpcb2|cadstar|spice|generic]"
+                              " [--spice-x-prefix] [--spice-net-numbers]"
+                              " [--erc] [--erc-report file]"
+                              " [--no-similar-labels] [--no-unique-global-labels]" ),
+                         REPORTER::RPT_ERROR );
+        return 2;
+    }
+
+    int errors = SchBatchNetlist( aKiway, options, reporter );
+
+    if( errors < 0 )
+        return 2;
+
+    return errors ? 1 : 0;
+}
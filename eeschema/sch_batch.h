@@ -0,0 +1,88 @@
+#ifndef _SCH_BATCH_H_
+#define _SCH_BATCH_H_
+
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2016 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file sch_batch.h
+ * @brief Netlist export and ERC run from the command line, without a schematic editor.
+ */
+
+#include <vector>
+#include <wx/string.h>
+
+
+class KIWAY;
+class REPORTER;
+
+
+/**
+ * Struct SCH_BATCH_OPTIONS
+ * describes what a SchBatchNetlist() job reads and writes.
+ */
+struct SCH_BATCH_OPTIONS
+{
+    wxString    m_SchematicFile;            ///< root sheet file, its project is loaded too
+    wxString    m_NetlistFile;              ///< empty: no netlist is written
+    int         m_NetlistFormat;            ///< a NETLIST_TYPE_ID
+    unsigned    m_NetlistOptions;           ///< netlistOptions bits
+    wxString    m_ErcFile;                  ///< empty: no ERC report is written
+    bool        m_RunErc;
+    bool        m_TestSimilarLabels;
+    bool        m_TestUniqueGlobalLabels;
+
+    SCH_BATCH_OPTIONS();
+};
+
+
+/**
+ * Function SchBatchNetlist
+ * loads a schematic hierarchy and the component libraries of its project without
+ * creating a SCH_EDIT_FRAME, builds the connected items list once, writes the
+ * netlist from it and runs the ERC on the same list.  Progress, problems and the
+ * time spent in each step are sent to \a aReporter.
+ *
+ * The loaded schematic becomes g_RootSheet, so this must not be called while a
+ * schematic editor is open.
+ *
+ * @return int - the number of ERC errors found, or -1 if the schematic could not
+ *               be loaded or a file could not be written.
+ */
+int SchBatchNetlist( KIWAY* aKiway, const SCH_BATCH_OPTIONS& aOptions, REPORTER& aReporter );
+
+
+/**
+ * Function SchBatchRun
+ * is the eeschema KIFACE_BATCH_FUNC, run by "eeschema --batch ...":
+ * <pre>
+ * eeschema --batch file.sch [--netlist file] [--format kicad|orcadpcb2|cadstar|spice|generic]
+ *                           [--spice-x-prefix] [--spice-net-numbers]
+ *                           [--erc] [--erc-report file] [--no-similar-labels]
+ *                           [--no-unique-global-labels]
+ * </pre>
+ * @return int - 0 on success, 1 if the ERC found errors, 2 if the job failed.
+ */
+int SchBatchRun( KIWAY* aKiway, const std::vector<wxString>& aArgs );
+
+#endif  // _SCH_BATCH_H_
@@ -26,6 +26,8 @@
 #include <wx/filename.h>
 #include <wx/tokenzr.h>
 
+#include <algorithm>
+
 #include <drawtxt.h>
 #include <kiway.h>
 #include <kicad_string.h>
@@ -433,10 +435,17 @@ SCH_LEGACY_PLUGIN::SCH_LEGACY_PLUGIN()
 }
 
 
+SCH_LEGACY_PLUGIN::~SCH_LEGACY_PLUGIN()
+{
+    freeParsedFiles();
+}
+
+
 void SCH_LEGACY_PLUGIN::init( KIWAY* aKiway, const PROPERTIES* aProperties )
 {
     m_version = 0;
     m_rootSheet = NULL;
+    m_deferBitmaps = false;
     m_props = aProperties;
     m_kiway = aKiway;
 }
@@ -467,6 +476,7 @@ SCH_SHEET* SCH_LEGACY_PLUGIN::Load( const wxString& aFileName, KIWAY* aKiway,
         std::unique_ptr< SCH_SHEET > newSheet( new SCH_SHEET );
         newSheet->SetFileName( aFileName );
         m_rootSheet = newSheet.get();
+        parseHierarchyFiles( newSheet.get() );
         loadHierarchy( newSheet.get() );
 
         // If we got here, the schematic loaded successfully.
@@ -477,13 +487,151 @@ SCH_SHEET* SCH_LEGACY_PLUGIN::Load( const wxString& aFileName, KIWAY* aKiway,
         m_rootSheet = aAppendToMe->GetRootSheet();
         wxASSERT( m_rootSheet != NULL );
         sheet = aAppendToMe;
+        parseHierarchyFiles( sheet );
         loadHierarchy( sheet );
     }
 
+    // Drop the files only used by sheets sharing a screen with another sheet.
+    freeParsedFiles();
+
     return sheet;
 }
 
 
+// Child sheet file names are relative to the project path.
+static wxString sheetFullPath( const wxString& aFileName, const wxString& aProjectPath )
+{
+    wxFileName fileName = aFileName;
+
+    if( !fileName.IsAbsolute() )
+        fileName.SetPath( aProjectPath );
+
+    return fileName.GetFullPath();
+}
+
+
+void SCH_LEGACY_PLUGIN::parseHierarchyFiles( SCH_SHEET* aSheet )
+{
+    freeParsedFiles();
+
+    if( aSheet->GetScreen() )
+        return;     // loadHierarchy() does not load anything either.
+
+    // Parse the files of the hierarchy one level at a time, all the files of a level in
+    // parallel.  loadHierarchy() then links the screens to the sheets in the same order
+    // as when it parsed the files itself.
+    std::vector<wxString> files( 1, sheetFullPath( aSheet->GetFileName(), m_path ) );
+
+    while( !files.empty() )
+    {
+        std::vector<PARSED_FILE> parsed( files.size() );
+
+        for( unsigned ii = 0; ii < files.size(); ii++ )
+        {
+            parsed[ii].m_screen = new SCH_SCREEN( m_kiway );
+            parsed[ii].m_screen->SetFileName( files[ii] );
+        }
+
+        // Each parser has its own plugin because the file version is parser state.
+#ifdef USE_OPENMP
+        #pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for( int ii = 0; ii < (int) files.size(); ii++ )
+        {
+            SCH_LEGACY_PLUGIN parser;
+
+            parser.init( m_kiway, m_props );
+            parser.m_path = m_path;
+            parser.m_deferBitmaps = true;
+
+            try
+            {
+                parser.loadFile( files[ii], parsed[ii].m_screen );
+            }
+            catch( ... )
+            {
+                // Thrown again by loadHierarchy() if it reaches this file.
+                parsed[ii].m_error = std::current_exception();
+            }
+        }
+
+        for( unsigned ii = 0; ii < files.size(); ii++ )
+        {
+            m_parsedFiles[ files[ii] ] = parsed[ii];
+
+            // wxBitmaps can only be created by the GUI thread.
+            for( EDA_ITEM* item = parsed[ii].m_screen->GetDrawItems();  item;  item = item->Next() )
+            {
+                if( item->Type() != SCH_BITMAP_T )
+                    continue;
+
+                BITMAP_BASE* image = ( (SCH_BITMAP*) item )->GetImage();
+
+                if( image->GetImageData() )
+                    image->SetBitmap( new wxBitmap( *image->GetImageData() ) );
+            }
+        }
+
+        std::vector<wxString> children;
+
+        for( unsigned ii = 0; ii < files.size(); ii++ )
+        {
+            if( !parsed[ii].m_error )
+                addSheetFiles( parsed[ii].m_screen, children );
+        }
+
+        files.swap( children );
+    }
+}
+
+
+void SCH_LEGACY_PLUGIN::addSheetFiles( SCH_SCREEN* aScreen, std::vector<wxString>& aFiles )
+{
+    for( EDA_ITEM* item = aScreen->GetDrawItems();  item;  item = item->Next() )
+    {
+        if( item->Type() != SCH_SHEET_T )
+            continue;
+
+        wxString fullPath = sheetFullPath( ( (SCH_SHEET*) item )->GetFileName(), m_path );
+
+        if( m_parsedFiles.find( fullPath ) == m_parsedFiles.end()
+          && std::find( aFiles.begin(), aFiles.end(), fullPath ) == aFiles.end() )
+            aFiles.push_back( fullPath );
+    }
+}
+
+
+SCH_SCREEN* SCH_LEGACY_PLUGIN::takeParsedFile( const wxString& aFullPath )
+{
+    std::map<wxString, PARSED_FILE>::iterator it = m_parsedFiles.find( aFullPath );
+
+    if( it == m_parsedFiles.end() )
+        return NULL;
+
+    PARSED_FILE parsed = it->second;
+
+    m_parsedFiles.erase( it );
+
+    if( parsed.m_error )
+    {
+        delete parsed.m_screen;
+        std::rethrow_exception( parsed.m_error );
+    }
+
+    return parsed.m_screen;
+}
+
+
+void SCH_LEGACY_PLUGIN::freeParsedFiles()
+{
+    for( std::map<wxString, PARSED_FILE>::iterator it = m_parsedFiles.begin();
+         it != m_parsedFiles.end();  ++it )
+        delete it->second.m_screen;
+
+    m_parsedFiles.clear();
+}
+
+
 // Everything below this comment is recursive.  Modify with care.
 
 void SCH_LEGACY_PLUGIN::loadHierarchy( SCH_SHEET* aSheet )
@@ -502,15 +650,20 @@ void SCH_LEGACY_PLUGIN::loadHierarchy( SCH_SHEET* aSheet )
         }
         else
         {
-            aSheet->SetScreen( new SCH_SCREEN( m_kiway ) );
+            wxString fileName = sheetFullPath( aSheet->GetFileName(), m_path );
 
-            wxFileName fileName = aSheet->GetFileName();
+            // The first sheet using a file gets the screen parseHierarchyFiles() parsed.
+            // A file used again by a sheet not sharing that screen is parsed again here.
+            screen = takeParsedFile( fileName );
 
-            if( !fileName.IsAbsolute() )
-                fileName.SetPath( m_path );
-
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
-            loadFile( fileName.GetFullPath(), aSheet->GetScreen() );
+            if( screen )
+                aSheet->SetScreen( screen );
+            else
+            {
+                aSheet->SetScreen( new SCH_SCREEN( m_kiway ) );
+                aSheet->GetScreen()->SetFileName( fileName );
+                loadFile( fileName, aSheet->GetScreen() );
+            }
 
             EDA_ITEM* item = aSheet->GetScreen()->GetDrawItems();
 
@@ -902,7 +1055,10 @@ SCH_BITMAP* SCH_LEGACY_PLUGIN::loadBitmap( FILE_LINE_READER& aReader )
                     wxMemoryInputStream istream( stream );
                     image->LoadFile( istream, wxBITMAP_TYPE_PNG );
                     bitmap->GetImage()->SetImage( image );
-                    bitmap->GetImage()->SetBitmap( new wxBitmap( *image ) );
+
+                    if( !m_deferBitmaps )
+                        bitmap->GetImage()->SetBitmap( new wxBitmap( *image ) );
+
                     break;
                 }
 
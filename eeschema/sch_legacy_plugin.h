@@ -25,6 +25,10 @@
 
 #include <sch_io_mgr.h>
 
+#include <exception>
+#include <map>
+#include <vector>
+
 
 class KIWAY;
 class LINE_READER;
@@ -79,9 +83,24 @@ public:
     //-----</PLUGIN IMPLEMENTATION>---------------------------------------------
 
     SCH_LEGACY_PLUGIN();
-    virtual ~SCH_LEGACY_PLUGIN() {}
+    virtual ~SCH_LEGACY_PLUGIN();
 
 private:
+    /**
+     * A sheet file parsed ahead of loadHierarchy() by parseHierarchyFiles(): either its
+     * screen, or the exception its parser threw.
+     */
+    struct PARSED_FILE
+    {
+        SCH_SCREEN*         m_screen;
+        std::exception_ptr  m_error;
+    };
+
+    void parseHierarchyFiles( SCH_SHEET* aSheet );
+    void addSheetFiles( SCH_SCREEN* aScreen, std::vector<wxString>& aFiles );
+    SCH_SCREEN* takeParsedFile( const wxString& aFullPath );
+    void freeParsedFiles();
+
     void loadHierarchy( SCH_SHEET* aSheet );
     void loadHeader( FILE_LINE_READER& aReader, SCH_SCREEN* aScreen );
     void loadPageSettings( FILE_LINE_READER& aReader, SCH_SCREEN* aScreen );
@@ -112,8 +131,13 @@ protected:
     const PROPERTIES* m_props;      ///< Passed via Save() or Load(), no ownership, may be NULL.
     KIWAY*            m_kiway;      ///< Required for path to legacy component libraries.
     SCH_SHEET*        m_rootSheet;  ///< The root sheet of the schematic being loaded..
+    bool              m_deferBitmaps; ///< Bitmap images are converted by the caller, see
+                                      ///< parseHierarchyFiles().
     FILE_OUTPUTFORMATTER* m_out;    ///< The output formatter for saving SCH_SCREEN objects.
 
+    /// Sheet files parsed and not linked to a sheet yet, by full path.
+    std::map<wxString, PARSED_FILE> m_parsedFiles;
+
     /// initialize PLUGIN like a constructor would.
     void init( KIWAY* aKiway, const PROPERTIES* aProperties = NULL );
 };
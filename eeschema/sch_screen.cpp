@@ -54,6 +54,9 @@
 #include <sch_text.h>
 #include <lib_pin.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 
 #define EESCHEMA_FILE_STAMP   "EESchema"
 
@@ -423,47 +426,212 @@ bool SCH_SCREEN::IsTerminalPoint( const wxPoint& aPosition, int aLayer )
 }
 
 
+/// Size of the cells of the wire and bus segment index used by TestDanglingEnds()
+#define DANGLING_INDEX_CELL_SIZE   512
+
+/// Key of a point (or of a cell) in the hash maps used to index the draw list
+static inline uint64_t pointKey( int aX, int aY )
+{
+    return ( (uint64_t) (uint32_t) aX << 32 ) | (uint32_t) aY;
+}
+
+
+/// Index of the cell of size \a aCellSize containing the coordinate \a aCoord
+static inline int cellIndex( int aCoord, int aCellSize )
+{
+    return aCoord >= 0 ? aCoord / aCellSize : -( ( -aCoord - 1 ) / aCellSize ) - 1;
+}
+
+
+/// A draw list item and its rank in the draw list, to test candidates in list order
+typedef std::pair< unsigned, SCH_ITEM* >                                RANKED_ITEM;
+typedef std::unordered_map< uint64_t, std::vector< RANKED_ITEM > >      ITEM_BUCKETS;
+
+
+static void removeFromBucket( ITEM_BUCKETS& aBuckets, uint64_t aKey, SCH_ITEM* aItem )
+{
+    std::vector< RANKED_ITEM >& bucket = aBuckets[aKey];
+
+    for( unsigned ii = 0; ii < bucket.size(); ii++ )
+    {
+        if( bucket[ii].second == aItem )
+        {
+            bucket.erase( bucket.begin() + ii );
+            return;
+        }
+    }
+}
+
+
+static void addLineEnds( ITEM_BUCKETS& aLineEnds, const RANKED_ITEM& aLine )
+{
+    SCH_LINE* line = (SCH_LINE*) aLine.second;
+
+    aLineEnds[ pointKey( line->GetStartPoint().x, line->GetStartPoint().y ) ].push_back( aLine );
+
+    if( line->GetEndPoint() != line->GetStartPoint() )
+        aLineEnds[ pointKey( line->GetEndPoint().x, line->GetEndPoint().y ) ].push_back( aLine );
+}
+
+
+static void removeLineEnds( ITEM_BUCKETS& aLineEnds, SCH_LINE* aLine )
+{
+    removeFromBucket( aLineEnds, pointKey( aLine->GetStartPoint().x, aLine->GetStartPoint().y ),
+                      aLine );
+
+    if( aLine->GetEndPoint() != aLine->GetStartPoint() )
+        removeFromBucket( aLineEnds, pointKey( aLine->GetEndPoint().x, aLine->GetEndPoint().y ),
+                          aLine );
+}
+
+
 bool SCH_SCREEN::SchematicCleanUp()
 {
-    bool      modified = false;
+    bool            modified = false;
+    unsigned        rank = 0;
+    int             cellSize = 1;
+    ITEM_BUCKETS    lineEnds;           // lines by end point
+    ITEM_BUCKETS    junctionCells;      // junctions by cell of cellSize
+    std::unordered_map< SCH_ITEM*, unsigned > ranks;
+
+    // A line can only be merged with a line sharing one of its ends, and a junction
+    // only overlaps the junctions closer than their size.  Index both so each item is
+    // tested against these candidates only, in the order the full scan of the draw
+    // list used, which keeps the result of the merges unchanged.
+    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    {
+        if( item->Type() == SCH_JUNCTION_T )
+        {
+            EDA_RECT bbox = item->GetBoundingBox();
+
+            cellSize = std::max( cellSize, std::max( bbox.GetWidth(), bbox.GetHeight() ) + 1 );
+        }
+    }
+
+    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next(), rank++ )
+    {
+        ranks[item] = rank;
+
+        if( item->Type() == SCH_LINE_T )
+        {
+            addLineEnds( lineEnds, RANKED_ITEM( rank, item ) );
+        }
+        else if( item->Type() == SCH_JUNCTION_T )
+        {
+            wxPoint pos = item->GetPosition();
+
+            junctionCells[ pointKey( cellIndex( pos.x, cellSize ), cellIndex( pos.y, cellSize ) ) ]
+                    .push_back( RANKED_ITEM( rank, item ) );
+        }
+    }
+
+    std::vector< RANKED_ITEM > candidates;
 
     for( SCH_ITEM* item = m_drawList.begin() ; item; item = item->Next() )
     {
         if( ( item->Type() != SCH_LINE_T ) && ( item->Type() != SCH_JUNCTION_T ) )
             continue;
 
-        bool restart;
+        // The items following this one are tested first.  After each merge, the scan
+        // starts again from the beginning of the draw list.
+        bool restarted = false;
+        bool merged;
 
-        for( SCH_ITEM* testItem = item->Next(); testItem; testItem = restart ? m_drawList.begin() : testItem->Next() )
+        do
         {
-            restart = false;
+            candidates.clear();
 
-            if( ( item->Type() == SCH_LINE_T ) && ( testItem->Type() == SCH_LINE_T ) )
+            if( item->Type() == SCH_LINE_T )
             {
                 SCH_LINE* line = (SCH_LINE*) item;
+                const std::vector< RANKED_ITEM >& atStart =
+                        lineEnds[ pointKey( line->GetStartPoint().x, line->GetStartPoint().y ) ];
+                const std::vector< RANKED_ITEM >& atEnd =
+                        lineEnds[ pointKey( line->GetEndPoint().x, line->GetEndPoint().y ) ];
 
-                if( line->MergeOverlap( (SCH_LINE*) testItem ) )
+                candidates.insert( candidates.end(), atStart.begin(), atStart.end() );
+                candidates.insert( candidates.end(), atEnd.begin(), atEnd.end() );
+            }
+            else
+            {
+                int cx = cellIndex( item->GetPosition().x, cellSize );
+                int cy = cellIndex( item->GetPosition().y, cellSize );
+
+                for( int x = cx - 1; x <= cx + 1; x++ )
                 {
-                    // Keep the current flags, because the deleted segment can be flagged.
-                    item->SetFlags( testItem->GetFlags() );
-                    DeleteItem( testItem );
-                    restart = true;
-                    modified = true;
+                    for( int y = cy - 1; y <= cy + 1; y++ )
+                    {
+                        ITEM_BUCKETS::const_iterator it = junctionCells.find( pointKey( x, y ) );
+
+                        if( it != junctionCells.end() )
+                            candidates.insert( candidates.end(), it->second.begin(),
+                                               it->second.end() );
+                    }
                 }
             }
-            else if ( ( ( item->Type() == SCH_JUNCTION_T )
-                      && ( testItem->Type() == SCH_JUNCTION_T ) ) && ( testItem != item ) )
+
+            if( !restarted )
+            {
+                unsigned itemRank = ranks[item];
+
+                candidates.erase( std::remove_if( candidates.begin(), candidates.end(),
+                                                  [itemRank]( const RANKED_ITEM& aCandidate )
+                                                  {
+                                                      return aCandidate.first <= itemRank;
+                                                  } ),
+                                  candidates.end() );
+            }
+
+            std::sort( candidates.begin(), candidates.end() );
+            candidates.erase( std::unique( candidates.begin(), candidates.end() ),
+                              candidates.end() );
+
+            merged = false;
+
+            for( const RANKED_ITEM& candidate : candidates )
             {
-                if ( testItem->HitTest( item->GetPosition() ) )
+                SCH_ITEM* testItem = candidate.second;
+
+                if( item->Type() == SCH_LINE_T )
+                {
+                    SCH_LINE* line = (SCH_LINE*) item;
+                    wxPoint   start = line->GetStartPoint();
+                    wxPoint   end = line->GetEndPoint();
+
+                    if( line->MergeOverlap( (SCH_LINE*) testItem ) )
+                    {
+                        removeFromBucket( lineEnds, pointKey( start.x, start.y ), line );
+
+                        if( end != start )
+                            removeFromBucket( lineEnds, pointKey( end.x, end.y ), line );
+
+                        removeLineEnds( lineEnds, (SCH_LINE*) testItem );
+                        addLineEnds( lineEnds, RANKED_ITEM( ranks[item], item ) );
+                        merged = true;
+                    }
+                }
+                else if( testItem != item && testItem->HitTest( item->GetPosition() ) )
+                {
+                    wxPoint pos = testItem->GetPosition();
+
+                    removeFromBucket( junctionCells, pointKey( cellIndex( pos.x, cellSize ),
+                                                               cellIndex( pos.y, cellSize ) ),
+                                      testItem );
+                    merged = true;
+                }
+
+                if( merged )
                 {
                     // Keep the current flags, because the deleted segment can be flagged.
                     item->SetFlags( testItem->GetFlags() );
+                    ranks.erase( testItem );
                     DeleteItem( testItem );
-                    restart = true;
+                    restarted = true;
                     modified = true;
+                    break;
                 }
             }
-        }
+        } while( merged );
     }
 
     TestDanglingEnds();
@@ -919,14 +1087,103 @@ bool SCH_SCREEN::TestDanglingEnds()
 {
     SCH_ITEM* item;
     std::vector< DANGLING_END_ITEM > endPoints;
+    std::vector< size_t > firstEndPoint;    // first entry of each item in endPoints
     bool hasStateChanged = false;
 
     for( item = m_drawList.begin(); item; item = item->Next() )
+    {
+        firstEndPoint.push_back( endPoints.size() );
         item->GetEndPoints( endPoints );
+    }
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
+    firstEndPoint.push_back( endPoints.size() );
+
+    // An item only tests the end points at its own connection points, and the wire
+    // and bus segments passing through them.  Index the end points by position and
+    // the segments (a start and end entry pair) by the cells they cross, then give
+    // each item only the entries found at its connection points, in their original
+    // order and with the segment pairs kept together.
+    std::unordered_map< uint64_t, std::vector< size_t > > pointIndex;
+    std::unordered_map< uint64_t, std::vector< size_t > > segmentIndex;
+    std::vector< size_t > slantedSegments;
+
+    for( size_t ii = 0; ii < endPoints.size(); ii++ )
+    {
+        const DANGLING_END_ITEM& end = endPoints[ii];
+        wxPoint pos = end.GetPosition();
+
+        if( ( end.GetType() == WIRE_START_END || end.GetType() == BUS_START_END )
+          && ii + 1 < endPoints.size() )
+        {
+            wxPoint segEnd = endPoints[ii + 1].GetPosition();
+
+            if( pos.x == segEnd.x || pos.y == segEnd.y )
+            {
+                int x0 = cellIndex( std::min( pos.x, segEnd.x ), DANGLING_INDEX_CELL_SIZE );
+                int x1 = cellIndex( std::max( pos.x, segEnd.x ), DANGLING_INDEX_CELL_SIZE );
+                int y0 = cellIndex( std::min( pos.y, segEnd.y ), DANGLING_INDEX_CELL_SIZE );
+                int y1 = cellIndex( std::max( pos.y, segEnd.y ), DANGLING_INDEX_CELL_SIZE );
+
+                for( int x = x0; x <= x1; x++ )
+                {
+                    for( int y = y0; y <= y1; y++ )
+                        segmentIndex[ pointKey( x, y ) ].push_back( ii );
+                }
+            }
+            else
+            {
+                slantedSegments.push_back( ii );
+            }
+
+            ii++;   // the end entry of the segment
+            continue;
+        }
+
+        pointIndex[ pointKey( pos.x, pos.y ) ].push_back( ii );
+    }
+
+    std::vector< size_t >            found;
+    std::vector< DANGLING_END_ITEM > candidates;
+    size_t                           itemIdx = 0;
+
+    for( item = m_drawList.begin(); item; item = item->Next(), itemIdx++ )
     {
-        if( item->IsDanglingStateChanged( endPoints ) )
+        found.clear();
+        candidates.clear();
+
+        for( size_t ii = firstEndPoint[itemIdx]; ii < firstEndPoint[itemIdx + 1]; ii++ )
+        {
+            wxPoint pos = endPoints[ii].GetPosition();
+            std::unordered_map< uint64_t, std::vector< size_t > >::const_iterator it;
+
+            it = pointIndex.find( pointKey( pos.x, pos.y ) );
+
+            if( it != pointIndex.end() )
+                found.insert( found.end(), it->second.begin(), it->second.end() );
+
+            it = segmentIndex.find( pointKey( cellIndex( pos.x, DANGLING_INDEX_CELL_SIZE ),
+                                              cellIndex( pos.y, DANGLING_INDEX_CELL_SIZE ) ) );
+
+            if( it != segmentIndex.end() )
+                found.insert( found.end(), it->second.begin(), it->second.end() );
+        }
+
+        if( firstEndPoint[itemIdx] != firstEndPoint[itemIdx + 1] )
+            found.insert( found.end(), slantedSegments.begin(), slantedSegments.end() );
+
+        std::sort( found.begin(), found.end() );
+        found.erase( std::unique( found.begin(), found.end() ), found.end() );
+
+        for( size_t idx : found )
+        {
+            candidates.push_back( endPoints[idx] );
+
+            if( ( endPoints[idx].GetType() == WIRE_START_END
+                || endPoints[idx].GetType() == BUS_START_END ) && idx + 1 < endPoints.size() )
+                candidates.push_back( endPoints[idx + 1] );
+        }
+
+        if( item->IsDanglingStateChanged( candidates ) )
             hasStateChanged = true;
     }
 
@@ -1416,15 +1673,22 @@ void SCH_SCREENS::ClearAnnotation()
 }
 
 
-void SCH_SCREENS::SchematicCleanUp()
+bool SCH_SCREENS::SchematicCleanUp()
 {
+    bool modified = false;
+
     for( size_t i = 0;  i < m_screens.size();  i++ )
     {
         // if wire list has changed, delete the undo/redo list to avoid
         // pointer problems with deleted data.
         if( m_screens[i]->SchematicCleanUp() )
+        {
             m_screens[i]->ClearUndoRedoList();
+            modified = true;
+        }
     }
+
+    return modified;
 }
 
 
@@ -348,6 +348,9 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ):
     m_dlgFindReplace = NULL;
     m_findReplaceData = new wxFindReplaceData( wxFR_DOWN );
     m_undoItem = NULL;
+    m_netListCache = NULL;
+    m_netListCacheLibs = NULL;
+    m_netListCacheLibsHash = 0;
     m_hasAutoSave = true;
 
     SetForceHVLines( true );
@@ -436,11 +439,13 @@ SCH_EDIT_FRAME::~SCH_EDIT_FRAME()
 
     delete m_CurrentSheet;          // a SCH_SHEET_PATH, on the heap.
     delete m_undoItem;
+    delete m_netListCache;
     delete g_RootSheet;
     delete m_findReplaceData;
 
     m_CurrentSheet = NULL;
     m_undoItem = NULL;
+    m_netListCache = NULL;
     g_RootSheet = NULL;
     m_findReplaceData = NULL;
 }
@@ -523,6 +528,8 @@ wxString SCH_EDIT_FRAME::GetScreenDesc() const
 
 void SCH_EDIT_FRAME::CreateScreens()
 {
+    InvalidateNetListCache();
+
     if( g_RootSheet == NULL )
     {
         g_RootSheet = new SCH_SHEET();
@@ -750,6 +757,7 @@ void SCH_EDIT_FRAME::OnModify()
     GetScreen()->SetSave();
 
     m_foundItems.SetForceSearch();
+    InvalidateNetListCache();
 }
 
 
@@ -1171,7 +1179,9 @@ void SCH_EDIT_FRAME::OnOpenLibraryEditor( wxCommandEvent& event )
         }
     }
 
-    GetScreen()->SchematicCleanUp();
+    if( GetScreen()->SchematicCleanUp() )
+        InvalidateNetListCache();
+
     m_canvas->Refresh();
 }
 
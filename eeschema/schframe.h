@@ -141,6 +141,9 @@ private:
     SCH_COLLECTOR           m_collectedItems;     ///< List of collected items.
     SCH_FIND_COLLECTOR      m_foundItems;         ///< List of find/replace items.
     SCH_ITEM*               m_undoItem;           ///< Copy of the current item being edited.
+    NETLIST_OBJECT_LIST*    m_netListCache;       ///< Connected items kept by BuildNetListBase().
+    PART_LIBS*              m_netListCacheLibs;   ///< Libraries used to build m_netListCache
+    int                     m_netListCacheLibsHash; ///< and their PART_LIBS::GetModifyHash().
     wxString                m_simulatorCommand;   ///< Command line used to call the circuit
                                                   ///< simulator (gnucap, spice, ...)
     wxString                m_netListerCommand;   ///< Command line to call a custom net list
@@ -497,10 +500,20 @@ public:
      * netlist generation:
      * Creates a flat list which stores all connected objects, and mainly
      * pins and labels.
+     * The list is built once and kept until the schematic or its libraries are
+     * modified, so several netlist exports or ERC runs share one connectivity pass.
      * @return NETLIST_OBJECT_LIST* - caller owns the object.
      */
     NETLIST_OBJECT_LIST* BuildNetListBase();
 
+    /**
+     * Function InvalidateNetListCache
+     * forgets the connected items kept by BuildNetListBase().  OnModify() and the undo
+     * and redo commands call it.  It must also be called when the schematic is modified
+     * without calling OnModify(), for instance by SCH_SCREEN::SchematicCleanUp().
+     */
+    void InvalidateNetListCache();
+
     /**
      * Function CreateNetlist
      * <ul>
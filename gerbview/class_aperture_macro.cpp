@@ -103,8 +103,8 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
 
     const int seg_per_circle = 64;   // Number of segments to approximate a circle
     // Draw the primitive shape for flashed items.
-    static std::vector<wxPoint> polybuffer;     // create a static buffer to avoid a lot of memory reallocation
-    polybuffer.clear();
+    // (not a static buffer: the shapes of several images can be built at the same time)
+    std::vector<wxPoint> polybuffer;
 
     wxPoint curPos = aShapePos;
     D_CODE* tool   = aParent->GetDcodeDescr();
@@ -120,7 +120,6 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
          * type is not stored in parameters list, so the first parameter is exposure
          */
         curPos += mapPt( params[2].GetValue( tool ), params[3].GetValue( tool ), m_GerbMetric );
-        curPos = aParent->GetABPosition( curPos );
         int radius = scaletoIU( params[1].GetValue( tool ), m_GerbMetric ) / 2;
 
         TransformCircleToPolygon( aShapeBuffer, curPos, radius, seg_per_circle );
@@ -153,7 +152,6 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
         {
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -185,7 +183,6 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
         {
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -213,7 +210,6 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
         {
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -250,7 +246,6 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
             for( unsigned jj = 0; jj < polybuffer.size(); jj++ )
             {
                 polybuffer[jj] += curPos;
-                polybuffer[jj] = aParent->GetABPosition( polybuffer[jj] );
             }
 
             TO_POLY_SHAPE;
@@ -278,7 +273,7 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
         int numCircles = KiROUND( params[5].GetValue( tool ) );
 
         // Draw circles:
-        wxPoint center = aParent->GetABPosition( curPos );
+        wxPoint center = curPos;
         // adjust outerDiam by this on each nested circle
         int diamAdjust = (gap + penThickness); //*2;     //Should we use * 2 ?
 
@@ -301,7 +296,6 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
             RotatePoint( &polybuffer[ii], -rotation );
             // Move to current position:
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -346,7 +340,6 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
         for( unsigned ii = 0; ii < polybuffer.size(); ii++ )
         {
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -373,7 +366,6 @@ void AM_PRIMITIVE::DrawBasicShape( GERBER_DRAW_ITEM* aParent,
         {
             RotatePoint( &polybuffer[ii], -rotation );
             polybuffer[ii] += curPos;
-            polybuffer[ii] = aParent->GetABPosition( polybuffer[ii] );
         }
 
         TO_POLY_SHAPE;
@@ -696,52 +688,40 @@ int AM_PRIMITIVE::GetShapeDim( GERBER_DRAW_ITEM* aParent )
 
 
 /*
- * Function DrawApertureMacroShape
- * Draw the primitive shape for flashed items.
- * When an item is flashed, this is the shape of the item
+ * Function BuildApertureMacroShape
+ * Build the polygonal shape of the aperture macro instance used by aParent,
+ * relative to the flash position
  */
-void APERTURE_MACRO::DrawApertureMacroShape( GERBER_DRAW_ITEM* aParent,
-                                             EDA_RECT* aClipBox, wxDC* aDC,
-                                             EDA_COLOR_T aColor,
-                                             wxPoint aShapePos, bool aFilledShape )
+void APERTURE_MACRO::BuildApertureMacroShape( GERBER_DRAW_ITEM* aParent,
+                                              SHAPE_POLY_SET& aShapeBuffer )
 {
-    SHAPE_POLY_SET shapeBuffer;
     SHAPE_POLY_SET holeBuffer;
     bool hasHole = false;
 
+    aShapeBuffer.RemoveAllContours();
+
     for( AM_PRIMITIVES::iterator prim_macro = primitives.begin();
          prim_macro != primitives.end(); ++prim_macro )
     {
         if( prim_macro->IsAMPrimitiveExposureOn( aParent ) )
-            prim_macro->DrawBasicShape( aParent, shapeBuffer, aShapePos );
+            prim_macro->DrawBasicShape( aParent, aShapeBuffer, wxPoint( 0, 0 ) );
         else
         {
-            prim_macro->DrawBasicShape( aParent, holeBuffer, aShapePos );
+            prim_macro->DrawBasicShape( aParent, holeBuffer, wxPoint( 0, 0 ) );
 
             if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
             {
-                shapeBuffer.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
+                aShapeBuffer.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
                 holeBuffer.RemoveAllContours();
                 hasHole = true;
             }
         }
     }
 
-    if( shapeBuffer.OutlineCount() == 0 )
-        return;
-
     // If a hole is defined inside a polygon, we must fracture the polygon
     // to be able to drawn it (i.e link holes by overlapping edges)
-    if( hasHole )
-        shapeBuffer.Fracture( SHAPE_POLY_SET::PM_FAST );
-
-    for( int ii = 0; ii < shapeBuffer.OutlineCount(); ii++ )
-    {
-        SHAPE_LINE_CHAIN& poly = shapeBuffer.Outline( ii );
-
-        GRClosedPoly( aClipBox, aDC,
-                      poly.PointCount(), (wxPoint*)&poly.Point( 0 ), aFilledShape, aColor, aColor );
-    }
+    if( hasHole && aShapeBuffer.OutlineCount() )
+        aShapeBuffer.Fracture( SHAPE_POLY_SET::PM_FAST );
 }
 
 /** GetShapeDim
@@ -132,6 +132,8 @@ public: AM_PRIMITIVE( bool aGerbMetric, AM_PRIMITIVE_ID aId = AMP_UNKNOWN )
     /**
      * Function drawBasicShape
      * Draw (in fact generate the actual polygonal shape of) the primitive shape of an aperture macro instance.
+     * The shape is given in the aperture macro coordinates: the transform of the
+     * parent item (GERBER_DRAW_ITEM::GetABPosition()) is not applied.
      * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
      * @param aShapeBuffer = a SHAPE_POLY_SET to put the shape converted to a polygon
      * @param aShapePos = the actual shape position
@@ -183,19 +185,16 @@ struct APERTURE_MACRO
      */
     double GetLocalParam( const D_CODE* aDcode, unsigned aParamId ) const;
 
-   /**
-     * Function DrawApertureMacroShape
-     * Draw the primitive shape for flashed items.
-     * When an item is flashed, this is the shape of the item
+    /**
+     * Function BuildApertureMacroShape
+     * Build the polygonal shape of the aperture macro instance used by a flashed item.
+     * The shape only depends on the macro and on the D_CODE parameters: it is built
+     * relative to the flash position, without the parent item transform, and can be
+     * cached by the D_CODE (see D_CODE::DrawFlashedShape()).
      * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
-     * @param aClipBox = DC clip box (NULL is no clip)
-     * @param aDC = device context
-     * @param aColor = the color of shape
-     * @param aShapePos = the actual shape position
-     * @param aFilledShape = true to draw in filled mode, false to draw in skecth mode
+     * @param aShapeBuffer = a SHAPE_POLY_SET to put the shape in. Holes are fractured.
      */
-    void DrawApertureMacroShape( GERBER_DRAW_ITEM* aParent, EDA_RECT* aClipBox, wxDC* aDC,
-                                 EDA_COLOR_T aColor, wxPoint aShapePos, bool aFilledShape );
+    void BuildApertureMacroShape( GERBER_DRAW_ITEM* aParent, SHAPE_POLY_SET& aShapeBuffer );
 
     /**
      * Function GetShapeDim
@@ -119,6 +119,7 @@ public: EXCELLON_IMAGE( int layer ) :
      * @param aFullFileName = the full filename of the Gerber file
      * when the file cannot be loaded
      * Warning and info messages are stored in m_Messages
+     * The caller must switch to the C locale, see GERBER_FILE_IMAGE::LoadGerberFile()
      * @return bool if OK, false if the gerber file was not loaded
      */
     bool LoadFile( const wxString& aFullFileName );
@@ -162,6 +162,8 @@ void GBR_LAYOUT::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDC, GR_DRAWMODE aDrawMode,
 
     bool doBlit = false; // this flag requests an image transfer to actual screen when true.
 
+    std::vector<GERBER_DRAW_ITEM*> visibleItems;
+
     bool end = false;
 
     // Draw graphic layers from bottom to top, and the active layer is on the top of others.
@@ -270,8 +272,13 @@ void GBR_LAYOUT::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDC, GR_DRAWMODE aDrawMode,
 
         // Now we can draw the current layer to the bitmap buffer
         // When needed, the previous bitmap is already copied to the screen buffer.
-        for( GERBER_DRAW_ITEM* item = gerber->GetItemsList(); item; item = item->Next() )
+        // Only the items inside the area to redraw are drawn.
+        gerber->GetItemsInBox( drawBox, visibleItems );
+
+        for( unsigned ii = 0; ii < visibleItems.size(); ii++ )
         {
+            GERBER_DRAW_ITEM* item = visibleItems[ii];
+
             if( item->GetLayer() != layer )
                 continue;
 
@@ -38,6 +38,33 @@
 #include <class_gerber_file_image.h>
 
 
+GBR_ITEM_PARAMS::GBR_ITEM_PARAMS() :
+    m_UnitsMetric( false ),
+    m_SwapAxis( false ),
+    m_MirrorA( false ),
+    m_MirrorB( false ),
+    m_DrawScale( 1.0, 1.0 ),
+    m_LyrRotation( 0 )
+{
+}
+
+
+bool GBR_ITEM_PARAMS::operator==( const GBR_ITEM_PARAMS& aOther ) const
+{
+    return m_UnitsMetric == aOther.m_UnitsMetric
+        && m_SwapAxis == aOther.m_SwapAxis
+        && m_MirrorA == aOther.m_MirrorA
+        && m_MirrorB == aOther.m_MirrorB
+        && m_DrawScale == aOther.m_DrawScale
+        && m_LayerOffset == aOther.m_LayerOffset
+        && m_LyrRotation == aOther.m_LyrRotation;
+}
+
+
+// The parameters of the items having no image
+static const GBR_ITEM_PARAMS defaultItemParams;
+
+
 GERBER_DRAW_ITEM::GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberImageFile ) :
     EDA_ITEM( (EDA_ITEM*)NULL, TYPE_GERBER_DRAW_ITEM )
 {
@@ -45,13 +72,9 @@ GERBER_DRAW_ITEM::GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberImageFile ) :
     m_Shape         = GBR_SEGMENT;
     m_Flashed       = false;
     m_DCode         = 0;
-    m_UnitsMetric   = false;
     m_LayerNegative = false;
-    m_swapAxis      = false;
-    m_mirrorA       = false;
-    m_mirrorB       = false;
-    m_drawScale.x   = m_drawScale.y = 1.0;
-    m_lyrRotation   = 0;
+    m_params        = &defaultItemParams;
+
     if( m_GerberImageFile )
         SetLayerParameters();
 }
@@ -75,25 +98,26 @@ wxPoint GERBER_DRAW_ITEM::GetABPosition( const wxPoint& aXYPosition ) const
      * For instance: Rotation must be made after or before mirroring ?
      * Note: if something is changed here, GetYXPosition must reflect changes
      */
+    const GBR_ITEM_PARAMS& params = *m_params;
     wxPoint abPos = aXYPosition + m_GerberImageFile->m_ImageJustifyOffset;
 
-    if( m_swapAxis )
+    if( params.m_SwapAxis )
         std::swap( abPos.x, abPos.y );
 
-    abPos  += m_layerOffset + m_GerberImageFile->m_ImageOffset;
-    abPos.x = KiROUND( abPos.x * m_drawScale.x );
-    abPos.y = KiROUND( abPos.y * m_drawScale.y );
-    double rotation = m_lyrRotation * 10 + m_GerberImageFile->m_ImageRotation * 10;
+    abPos  += params.m_LayerOffset + m_GerberImageFile->m_ImageOffset;
+    abPos.x = KiROUND( abPos.x * params.m_DrawScale.x );
+    abPos.y = KiROUND( abPos.y * params.m_DrawScale.y );
+    double rotation = params.m_LyrRotation * 10 + m_GerberImageFile->m_ImageRotation * 10;
 
     if( rotation )
         RotatePoint( &abPos, -rotation );
 
     // Negate A axis if mirrored
-    if( m_mirrorA )
+    if( params.m_MirrorA )
         abPos.x = -abPos.x;
 
     // abPos.y must be negated when no mirror, because draw axis is top to bottom
-    if( !m_mirrorB )
+    if( !params.m_MirrorB )
         abPos.y = -abPos.y;
     return abPos;
 }
@@ -102,24 +126,25 @@ wxPoint GERBER_DRAW_ITEM::GetABPosition( const wxPoint& aXYPosition ) const
 wxPoint GERBER_DRAW_ITEM::GetXYPosition( const wxPoint& aABPosition ) const
 {
     // do the inverse transform made by GetABPosition
+    const GBR_ITEM_PARAMS& params = *m_params;
     wxPoint xyPos = aABPosition;
 
-    if( m_mirrorA )
+    if( params.m_MirrorA )
         xyPos.x = -xyPos.x;
 
-    if( !m_mirrorB )
+    if( !params.m_MirrorB )
         xyPos.y = -xyPos.y;
 
-    double rotation = m_lyrRotation * 10 + m_GerberImageFile->m_ImageRotation * 10;
+    double rotation = params.m_LyrRotation * 10 + m_GerberImageFile->m_ImageRotation * 10;
 
     if( rotation )
         RotatePoint( &xyPos, rotation );
 
-    xyPos.x = KiROUND( xyPos.x / m_drawScale.x );
-    xyPos.y = KiROUND( xyPos.y / m_drawScale.y );
-    xyPos  -= m_layerOffset + m_GerberImageFile->m_ImageOffset;
+    xyPos.x = KiROUND( xyPos.x / params.m_DrawScale.x );
+    xyPos.y = KiROUND( xyPos.y / params.m_DrawScale.y );
+    xyPos  -= params.m_LayerOffset + m_GerberImageFile->m_ImageOffset;
 
-    if( m_swapAxis )
+    if( params.m_SwapAxis )
         std::swap( xyPos.x, xyPos.y );
 
     return xyPos - m_GerberImageFile->m_ImageJustifyOffset;
@@ -128,17 +153,7 @@ wxPoint GERBER_DRAW_ITEM::GetXYPosition( const wxPoint& aABPosition ) const
 
 void GERBER_DRAW_ITEM::SetLayerParameters()
 {
-    m_UnitsMetric = m_GerberImageFile->m_GerbMetric;
-    m_swapAxis    = m_GerberImageFile->m_SwapAxis;     // false if A = X, B = Y;
-
-    // true if A =Y, B = Y
-    m_mirrorA     = m_GerberImageFile->m_MirrorA;      // true: mirror / axe A
-    m_mirrorB     = m_GerberImageFile->m_MirrorB;      // true: mirror / axe B
-    m_drawScale   = m_GerberImageFile->m_Scale;        // A and B scaling factor
-    m_layerOffset = m_GerberImageFile->m_Offset;       // Offset from OF command
-
-    // Rotation from RO command:
-    m_lyrRotation = m_GerberImageFile->m_LocalRotation;
+    m_params = m_GerberImageFile->GetItemParams();
     m_LayerNegative = m_GerberImageFile->GetLayerParams().m_LayerNegative;
 }
 
@@ -205,16 +220,49 @@ const EDA_RECT GERBER_DRAW_ITEM::GetBoundingBox() const
     // return a rectangle which is (pos,dim) in nature.  therefore the +1
     EDA_RECT bbox( m_Start, wxSize( 1, 1 ) );
 
-    bbox.Inflate( m_Size.x / 2, m_Size.y / 2 );
+    // Calculate the box of the whole shape, in XY (gerber file) coordinates
+    switch( m_Shape )
+    {
+    case GBR_POLYGON:
+        for( unsigned ii = 0; ii < m_PolyCorners.size(); ii++ )
+            bbox.Merge( m_PolyCorners[ii] );
+
+        break;
+
+    case GBR_CIRCLE:
+        bbox.Inflate( KiROUND( GetLineLength( m_Start, m_End ) ) + m_Size.x / 2 );
+        break;
+
+    case GBR_ARC:
+        // Use the box of the full circle
+        bbox = EDA_RECT( m_ArcCentre, wxSize( 1, 1 ) );
+        bbox.Inflate( KiROUND( GetLineLength( m_Start, m_ArcCentre ) ) + m_Size.x / 2 );
+        break;
+
+    case GBR_SEGMENT:
+        bbox.Merge( m_End );
+        bbox.Inflate( std::max( m_Size.x, m_Size.y ) / 2 );
+        break;
+
+    default:    // Flashed shapes
+        bbox.Inflate( std::max( m_Size.x, m_Size.y ) / 2 );
+        break;
+    }
+
+    // calculate the corners coordinates in current gerber axis orientations.
+    // All the corners are needed, because the image or the layer can be rotated
+    wxPoint corners[4] =
+    {
+        GetABPosition( bbox.GetOrigin() ),
+        GetABPosition( bbox.GetEnd() ),
+        GetABPosition( wxPoint( bbox.GetX(), bbox.GetBottom() ) ),
+        GetABPosition( wxPoint( bbox.GetRight(), bbox.GetY() ) )
+    };
 
-    // calculate the corners coordinates in current gerber axis orientations
-    wxPoint org = GetABPosition( bbox.GetOrigin() );
-    wxPoint end = GetABPosition( bbox.GetEnd() );
+    bbox = EDA_RECT( corners[0], wxSize( 0, 0 ) );
 
-    // Set the corners position:
-    bbox.SetOrigin( org );
-    bbox.SetEnd( end );
-    bbox.Normalize();
+    for( int ii = 1; ii < 4; ii++ )
+        bbox.Merge( corners[ii] );
 
     return bbox;
 }
@@ -497,10 +545,10 @@ void GERBER_DRAW_ITEM::GetMsgPanelInfo( std::vector< MSG_PANEL_ITEM >& aList )
     aList.push_back( MSG_PANEL_ITEM( _( "Graphic Layer" ), msg, BROWN ) );
 
     // Display item rotation
-    // The full rotation is Image rotation + m_lyrRotation
-    // but m_lyrRotation is specific to this object
+    // The full rotation is Image rotation + m_LyrRotation
+    // but m_LyrRotation is specific to this object
     // so we display only this parameter
-    msg.Printf( wxT( "%f" ), m_lyrRotation );
+    msg.Printf( wxT( "%f" ), m_params->m_LyrRotation );
     aList.push_back( MSG_PANEL_ITEM( _( "Rotation" ), msg, BLUE ) );
 
     // Display item polarity (item specific)
@@ -509,12 +557,12 @@ void GERBER_DRAW_ITEM::GetMsgPanelInfo( std::vector< MSG_PANEL_ITEM >& aList )
 
     // Display mirroring (item specific)
     msg.Printf( wxT( "A:%s B:%s" ),
-                m_mirrorA ? _("Yes") : _("No"),
-                m_mirrorB ? _("Yes") : _("No"));
+                m_params->m_MirrorA ? _("Yes") : _("No"),
+                m_params->m_MirrorB ? _("Yes") : _("No"));
     aList.push_back( MSG_PANEL_ITEM( _( "Mirror" ), msg, DARKRED ) );
 
     // Display AB axis swap (item specific)
-    msg = m_swapAxis ? wxT( "A=Y B=X" ) : wxT( "A=X B=Y" );
+    msg = m_params->m_SwapAxis ? wxT( "A=Y B=X" ) : wxT( "A=X B=Y" );
     aList.push_back( MSG_PANEL_ITEM( _( "AB axis" ), msg, DARKRED ) );
 }
 
@@ -55,7 +55,27 @@ enum Gbr_Basic_Shapes {
     GBR_LAST                // last value for this list
 };
 
-/***/
+/**
+ * Struct GBR_ITEM_PARAMS
+ * holds the image and layer parameters a GERBER_DRAW_ITEM is drawn with.  They can
+ * change inside a gerber file but seldom do, so the items created with the same
+ * values share one instance, owned by their image (see GERBER_FILE_IMAGE::GetItemParams()).
+ */
+struct GBR_ITEM_PARAMS
+{
+    bool        m_UnitsMetric;              // the gerber units (inch/mm)
+    bool        m_SwapAxis;                 // false if A = X, B = Y; true if A = Y, B = X
+    bool        m_MirrorA;                  // true: mirror / axe A
+    bool        m_MirrorB;                  // true: mirror / axe B
+    wxRealPoint m_DrawScale;                // A and B scaling factor
+    wxPoint     m_LayerOffset;              // Offset for A and B axis, from OF parameter
+    double      m_LyrRotation;              // Fine rotation, from OR parameter, in degrees
+
+    GBR_ITEM_PARAMS();
+
+    bool operator==( const GBR_ITEM_PARAMS& aOther ) const;
+};
+
 
 class GERBER_DRAW_ITEM : public EDA_ITEM
 {
@@ -66,23 +86,27 @@ private:
     void SetBack( EDA_ITEM* aBack )       { Pback = aBack; }
 
 
+    // Large images have millions of items: the members are ordered to avoid padding.
 public:
-    bool    m_UnitsMetric;                  /* store here the gerber units (inch/mm).  Used
-                                             * only to calculate aperture macros shapes sizes */
     int     m_Shape;                        // Shape and type of this gerber item
+    int     m_DCode;                        // DCode used to draw this item.
+                                            // 0 for items that do not use DCodes (polygons)
+                                            // or when unknown and normal values are 10 to 999
+                                            // values 0 to 9 can be used for special purposes
+    bool    m_Flashed;                      // True for flashed items
+
+private:
+    bool    m_LayerNegative;                // true = item in negative Layer
+
+public:
     wxPoint m_Start;                        // Line or arc start point or position of the shape
                                             // for flashed items
     wxPoint m_End;                          // Line or arc end point
     wxPoint m_ArcCentre;                    // for arcs only: Centre of arc
-    std::vector <wxPoint> m_PolyCorners;    // list of corners for polygons (G36 to G37 coordinates)
-                                            // or for complex shapes which are converted to polygon
     wxSize  m_Size;                         // Flashed shapes: size of the shape
                                             // Lines : m_Size.x = m_Size.y = line width
-    bool    m_Flashed;                      // True for flashed items
-    int     m_DCode;                        // DCode used to draw this item.
-                                            // 0 for items that do not use DCodes (polygons)
-                                            // or when unknown and normal values are 10 to 999
-                                            // values 0 to 9 can be used for special purposes
+    std::vector <wxPoint> m_PolyCorners;    // list of corners for polygons (G36 to G37 coordinates)
+                                            // or for complex shapes which are converted to polygon
     GERBER_FILE_IMAGE* m_GerberImageFile;   /* Gerber file image source of this item
                                              * Note: some params stored in this class are common
                                              * to the whole gerber file (i.e) the whole graphic
@@ -91,16 +115,10 @@ public:
                                              * redundancy for these parameters
                                              */
 private:
-    // These values are used to draw this item, according to gerber layers parameters
-    // Because they can change inside a gerber image, they are stored here
-    // for each item
-    bool        m_LayerNegative;            // true = item in negative Layer
-    bool        m_swapAxis;                 // false if A = X, B = Y; true if A =Y, B = Y
-    bool        m_mirrorA;                  // true: mirror / axe A
-    bool        m_mirrorB;                  // true: mirror / axe B
-    wxRealPoint m_drawScale;                // A and B scaling factor
-    wxPoint     m_layerOffset;              // Offset for A and B axis, from OF parameter
-    double      m_lyrRotation;              // Fine rotation, from OR parameter, in degrees
+    // These values are used to draw this item, according to gerber layers parameters.
+    // Because they can change inside a gerber image, each item points to the values
+    // it was created with.
+    const GBR_ITEM_PARAMS* m_params;
 
 public:
     GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberparams );
@@ -133,9 +151,8 @@ public:
      * Function SetLayerParameters
      * Initialize parameters from Image and Layer parameters
      * found in the gerber file:
-     *   m_UnitsMetric,
-     *   m_MirrorA, m_MirrorB,
-     *   m_DrawScale, m_DrawOffset
+     *   the polarity, and the shared GBR_ITEM_PARAMS
+     *   (units, mirror, scale, offset and rotation)
      */
     void SetLayerParameters();
 
@@ -117,6 +117,27 @@ GERBER_FILE_IMAGE::~GERBER_FILE_IMAGE()
     delete m_FileFunction;
 }
 
+
+const GBR_ITEM_PARAMS* GERBER_FILE_IMAGE::GetItemParams()
+{
+    GBR_ITEM_PARAMS params;
+
+    params.m_UnitsMetric = m_GerbMetric;
+    params.m_SwapAxis    = m_SwapAxis;
+    params.m_MirrorA     = m_MirrorA;
+    params.m_MirrorB     = m_MirrorB;
+    params.m_DrawScale   = m_Scale;
+    params.m_LayerOffset = m_Offset;         // Offset from OF command
+    params.m_LyrRotation = m_LocalRotation;  // Rotation from RO command
+
+    // The parameters seldom change: comparing to the last ones is enough
+    if( m_itemParams.empty() || !( m_itemParams.back() == params ) )
+        m_itemParams.push_back( params );
+
+    return &m_itemParams.back();
+}
+
+
 /*
  * Function GetItemsList
  * returns the first GERBER_DRAW_ITEM * item of the items list
@@ -126,6 +147,75 @@ GERBER_DRAW_ITEM * GERBER_FILE_IMAGE::GetItemsList()
     return m_Drawings;
 }
 
+
+void GERBER_FILE_IMAGE::buildItemsIndex()
+{
+    m_itemsIndex.RemoveAll();
+    m_indexedItems.clear();
+    m_unboundedItems.clear();
+
+    m_indexedItems.reserve( m_Drawings.GetCount() );
+
+    for( GERBER_DRAW_ITEM* item = GetItemsList(); item; item = item->Next() )
+    {
+        int position = m_indexedItems.size();
+
+        m_indexedItems.push_back( item );
+
+        // The extent of aperture macro shapes is not known without building them
+        if( item->m_Shape == GBR_SPOT_MACRO )
+        {
+            m_unboundedItems.push_back( position );
+            continue;
+        }
+
+        EDA_RECT    bbox = item->GetBoundingBox();
+        const int   mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int   mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+        m_itemsIndex.Insert( mmin, mmax, position );
+    }
+
+    m_itemsIndexValid = true;
+}
+
+
+void GERBER_FILE_IMAGE::GetItemsInBox( const EDA_RECT& aBox,
+                                       std::vector<GERBER_DRAW_ITEM*>& aList )
+{
+    if( !m_itemsIndexValid )
+        buildItemsIndex();
+
+    wxASSERT_MSG( m_indexedItems.size() == m_Drawings.GetCount(),
+                  wxT( "items list changed without InvalidateItemsIndex()" ) );
+
+    std::vector<int> found = m_unboundedItems;
+
+    EDA_RECT    box = aBox;
+    box.Normalize();
+
+    const int   mmin[2] = { box.GetX(), box.GetY() };
+    const int   mmax[2] = { box.GetRight(), box.GetBottom() };
+
+    auto collect = [&found]( int aPosition ) -> bool
+    {
+        found.push_back( aPosition );
+        return true;
+    };
+
+    m_itemsIndex.Search( mmin, mmax, collect );
+
+    // Items must be drawn in the list order, because negative items erase the
+    // items drawn before them
+    std::sort( found.begin(), found.end() );
+
+    aList.clear();
+    aList.reserve( found.size() );
+
+    for( unsigned ii = 0; ii < found.size(); ii++ )
+        aList.push_back( m_indexedItems[found[ii]] );
+}
+
 D_CODE* GERBER_FILE_IMAGE::GetDCODE( int aDCODE, bool aCreateIfNoExist )
 {
     unsigned ndx = aDCODE - FIRST_DCODE;
@@ -173,6 +263,7 @@ void GERBER_FILE_IMAGE::ResetDefaultValues()
     m_MD5_value.Empty();                            // MD5 value found in a %TF.MD5 command
     m_PartString.Empty();                           // string found in a %TF.Part command
     m_hasNegativeItems    = -1;                     // set to uninitialized
+    m_itemsIndexValid     = false;                  // items index not yet built
     m_ImageJustifyOffset  = wxPoint(0,0);           // Image justify Offset
     m_ImageJustifyXCenter = false;                  // Image Justify Center on X axis (default = false)
     m_ImageJustifyYCenter = false;                  // Image Justify Center on Y axis (default = false)
@@ -306,7 +397,7 @@ void GERBER_FILE_IMAGE::StepAndRepeatItem( const GERBER_DRAW_ITEM& aItem )
             move_vector.y = scaletoIU( jj * GetLayerParams().m_StepForRepeat.y,
                                    GetLayerParams().m_StepForRepeatMetric );
             dupItem->MoveXY( move_vector );
-            m_Drawings.Append( dupItem );
+            AddItem( dupItem );
         }
     }
 }
@@ -26,8 +26,10 @@
 #define CLASS_GERBER_FILE_IMAGE_H
 
 #include <vector>
+#include <deque>
 #include <set>
 
+#include <geometry/rtree.h>
 #include <dcode.h>
 #include <class_gerber_draw_item.h>
 #include <class_aperture_macro.h>
@@ -168,6 +170,20 @@ private:
                                                                 // 0 = no negative items found
                                                                 // 1 = have negative items found
 
+    /// Spatial index of m_Drawings: the position of the items in the list, by bounding box
+    typedef RTree<int, int, 2, float> ITEMS_INDEX;
+
+    ITEMS_INDEX        m_itemsIndex;
+    std::vector<GERBER_DRAW_ITEM*> m_indexedItems;              // m_Drawings, when m_itemsIndex was built
+    std::vector<int>   m_unboundedItems;                        // indexed items without bounding box
+    bool               m_itemsIndexValid;
+
+    /// The draw parameters shared by the items, see GetItemParams().  A deque, because
+    /// the items keep pointers to its elements.
+    std::deque<GBR_ITEM_PARAMS> m_itemParams;
+
+    void buildItemsIndex();
+
 public:
     GERBER_FILE_IMAGE( int layer );
     virtual ~GERBER_FILE_IMAGE();
@@ -179,6 +195,8 @@ public:
      * @param aFullFileName = the full filename of the Gerber file
      * when the file cannot be loaded
      * Warning and info messages are stored in m_messagesList
+     * The caller must switch to the C locale (LOCALE_IO): several files can be
+     * read at once, and LOCALE_IO cannot be used by several threads.
      * @return bool if OK, false if the gerber file was not loaded
      */
     bool LoadGerberFile( const wxString& aFullFileName );
@@ -200,6 +218,46 @@ public:
      */
     GERBER_DRAW_ITEM * GetItemsList();
 
+    /**
+     * Function AddItem
+     * appends \a aItem to the items list, which owns it from now on.
+     */
+    void AddItem( GERBER_DRAW_ITEM* aItem )
+    {
+        m_Drawings.Append( aItem );
+        InvalidateItemsIndex();
+    }
+
+    /**
+     * Function GetItemsInBox
+     * finds the items which can be seen in \a aBox, in the order of the items list
+     * (which is also the drawing order).  A spatial index of the items is built on
+     * the first call, so redrawing a part of a large image does not test all items.
+     * @param aBox = the area to test, in drawing (AB) coordinates
+     * @param aList = the list to fill
+     */
+    void GetItemsInBox( const EDA_RECT& aBox, std::vector<GERBER_DRAW_ITEM*>& aList );
+
+    /**
+     * Function InvalidateItemsIndex
+     * must be called when items are added to or removed from m_Drawings, when items
+     * are moved or changed, and when an image parameter used by
+     * GERBER_DRAW_ITEM::GetABPosition() changes: the index keeps pointers to the items
+     * and their bounding boxes.
+     */
+    void InvalidateItemsIndex()
+    {
+        m_itemsIndexValid = false;
+    }
+
+    /**
+     * Function GetItemParams
+     * returns the draw parameters of the items created now, from the current image and
+     * layer parameters.  They are shared with the previous items having the same values.
+     * They are kept as long as this image, even if the items using them are deleted.
+     */
+    const GBR_ITEM_PARAMS* GetItemParams();
+
     /**
      * Function GetLayerParams
      * @return the current layers params
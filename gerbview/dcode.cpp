@@ -88,6 +88,7 @@ void D_CODE::Clear_D_CODE_Data()
     m_Rotation   = 0.0;
     m_EdgesCount = 0;
     m_PolyCorners.clear();
+    m_MacroShape.RemoveAllContours();
 }
 
 
@@ -150,6 +151,16 @@ int D_CODE::GetShapeDim( GERBER_DRAW_ITEM* aParent )
 }
 
 
+const SHAPE_POLY_SET& D_CODE::GetMacroShape( GERBER_DRAW_ITEM* aParent )
+{
+    // The macro shape only depends on the macro and on m_am_params: build it once
+    if( m_MacroShape.OutlineCount() == 0 && m_Macro )
+        m_Macro->BuildApertureMacroShape( aParent, m_MacroShape );
+
+    return m_MacroShape;
+}
+
+
 void D_CODE::DrawFlashedShape(  GERBER_DRAW_ITEM* aParent,
                                 EDA_RECT* aClipBox, wxDC* aDC, EDA_COLOR_T aColor,
                                 wxPoint aShapePos, bool aFilledShape )
@@ -159,8 +170,8 @@ void D_CODE::DrawFlashedShape(  GERBER_DRAW_ITEM* aParent,
     switch( m_Shape )
     {
     case APT_MACRO:
-        GetMacro()->DrawApertureMacroShape( aParent, aClipBox, aDC, aColor,
-                                            aShapePos, aFilledShape);
+        GetMacroShape( aParent );
+        DrawFlashedMacroShape( aParent, aClipBox, aDC, aColor, aFilledShape, aShapePos );
         break;
 
     case APT_CIRCLE:
@@ -287,6 +298,35 @@ void D_CODE::DrawFlashedPolygon( GERBER_DRAW_ITEM* aParent,
 }
 
 
+void D_CODE::DrawFlashedMacroShape( GERBER_DRAW_ITEM* aParent,
+                                    EDA_RECT* aClipBox, wxDC* aDC,
+                                    EDA_COLOR_T aColor, bool aFilled,
+                                    const wxPoint& aPosition )
+{
+    std::vector<wxPoint> points;
+
+    for( int ii = 0; ii < m_MacroShape.OutlineCount(); ii++ )
+    {
+        const SHAPE_LINE_CHAIN& poly = m_MacroShape.COutline( ii );
+
+        if( poly.PointCount() == 0 )
+            continue;
+
+        points.clear();
+        points.reserve( poly.PointCount() );
+
+        for( int jj = 0; jj < poly.PointCount(); jj++ )
+        {
+            const VECTOR2I& corner = poly.CPoint( jj );
+
+            points.push_back( aParent->GetABPosition( wxPoint( corner.x, corner.y ) + aPosition ) );
+        }
+
+        GRClosedPoly( aClipBox, aDC, points.size(), &points[0], aFilled, aColor, aColor );
+    }
+}
+
+
 #define SEGS_CNT 32     // number of segments to approximate a circle
 
 
@@ -33,6 +33,7 @@
 #include <vector>
 
 #include <base_struct.h>
+#include <geometry/shape_poly_set.h>
 
 
 class GERBER_DRAW_ITEM;
@@ -91,6 +92,11 @@ private:
                                              * (shapes with hole )
                                              */
 
+    SHAPE_POLY_SET        m_MacroShape;     /* Shape of an aperture macro instance, relative to
+                                             * the flash position. Built on first draw, because
+                                             * it only depends on the macro and m_am_params
+                                             */
+
 public:
     wxSize                m_Size;           /* Horizontal and vertical dimensions. */
     APERTURE_T            m_Shape;          /* shape ( Line, rectangle, circle , oval .. ) */
@@ -116,6 +122,7 @@ public:
     void AppendParam( double aValue )
     {
         m_am_params.push_back( aValue );
+        m_MacroShape.RemoveAllContours();
     }
 
     /**
@@ -145,6 +152,7 @@ public:
     void SetMacro( APERTURE_MACRO* aMacro )
     {
         m_Macro = aMacro;
+        m_MacroShape.RemoveAllContours();
     }
 
 
@@ -189,6 +197,20 @@ public:
                              EDA_RECT* aClipBox, wxDC* aDC, EDA_COLOR_T aColor,
                              bool aFilled, const wxPoint& aPosition );
 
+    /**
+     * Function DrawFlashedMacroShape
+     * a helper function used to draw the aperture macro shape stored in m_MacroShape
+     * @param aParent = the GERBER_DRAW_ITEM being drawn
+     * @param aClipBox = DC clip box (NULL is no clip)
+     * @param aDC = device context
+     * @param aColor = the normal color to use
+     * @param aFilled = true to draw in filled mode, false to draw in sketch mode
+     * @param aPosition = the actual shape position
+     */
+    void DrawFlashedMacroShape( GERBER_DRAW_ITEM* aParent,
+                                EDA_RECT* aClipBox, wxDC* aDC, EDA_COLOR_T aColor,
+                                bool aFilled, const wxPoint& aPosition );
+
     /**
      * Function ConvertShapeToPolygon
      * convert a shape to an equivalent polygon.
@@ -198,6 +220,28 @@ public:
      */
     void ConvertShapeToPolygon();
 
+    /**
+     * Function GetFlashedPolygon
+     * returns the shape of a circle, rectangle, oval or polygon aperture (with its hole,
+     * if any) converted to a polygon relative to the flash position.
+     * The polygon is built by ConvertShapeToPolygon() on first use.
+     */
+    const std::vector<wxPoint>& GetFlashedPolygon()
+    {
+        if( m_PolyCorners.size() == 0 )
+            ConvertShapeToPolygon();
+
+        return m_PolyCorners;
+    }
+
+    /**
+     * Function GetMacroShape
+     * returns the shape of the aperture macro instance this D_CODE defines, relative
+     * to the flash position.  The shape is built on first use.
+     * @param aParent = a GERBER_DRAW_ITEM flashed with this D_CODE
+     */
+    const SHAPE_POLY_SET& GetMacroShape( GERBER_DRAW_ITEM* aParent );
+
     /**
      * Function GetShapeDim
      * calculates a value that can be used to evaluate the size of text
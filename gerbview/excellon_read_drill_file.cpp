@@ -75,6 +75,7 @@
 #include <class_X2_gerber_attributes.h>
 
 #include <cmath>
+#include <clocale>
 
 #include <html_messagebox.h>
 
@@ -157,45 +158,6 @@ static EXCELLON_CMD excellon_G_CmdList[] =
 };
 
 
-bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
-{
-    wxString msg;
-    int layerId = getActiveLayer();      // current layer used in GerbView
-    GERBER_FILE_IMAGE_LIST* images = GetGerberLayout()->GetImagesList();
-    EXCELLON_IMAGE* drill_Layer = (EXCELLON_IMAGE*) images->GetGbrImage( layerId );
-
-    if( drill_Layer == NULL )
-    {
-        drill_Layer = new EXCELLON_IMAGE( layerId );
-        layerId = images->AddGbrImage( drill_Layer, layerId );
-    }
-
-    if( layerId < 0 )
-    {
-        DisplayError( this, _( "No room to load file" ) );
-        return false;
-    }
-
-    // Read the Excellon drill file:
-    bool success = drill_Layer->LoadFile( aFullFileName );
-
-    if( !success )
-    {
-        msg.Printf( _( "File %s not found" ), GetChars( aFullFileName ) );
-        DisplayError( this, msg );
-        return false;
-    }
-
-    // Display errors list
-    if( drill_Layer->GetMessages().size() > 0 )
-    {
-        HTML_MESSAGE_BOX dlg( this, _( "Error reading EXCELLON drill file" ) );
-        dlg.ListSet( drill_Layer->GetMessages() );
-        dlg.ShowModal();
-    }
-    return success;
-}
-
 /*
  * Read a EXCELLON file.
  * Gerber classes are used because there is likeness between Gerber files
@@ -211,6 +173,9 @@ bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
 
 bool EXCELLON_IMAGE::LoadFile( const wxString & aFullFileName )
 {
+    // The numbers are read with strtod() and atof(): see LOCALE_IO in the caller
+    wxASSERT_MSG( *localeconv()->decimal_point == '.', wxT( "C locale expected" ) );
+
     // Set the default parmeter values:
     ResetDefaultValues();
     ClearMessageList();
@@ -222,8 +187,6 @@ bool EXCELLON_IMAGE::LoadFile( const wxString & aFullFileName )
 
     m_FileName = aFullFileName;
 
-    LOCALE_IO toggleIo;
-
     // FILE_LINE_READER will close the file.
     FILE_LINE_READER excellonReader( m_Current_File, m_FileName );
 
@@ -543,7 +506,7 @@ bool EXCELLON_IMAGE::Execute_Drill_Command( char*& text )
                 }
 
                 gbritem = new GERBER_DRAW_ITEM( this );
-                m_Drawings.Append( gbritem );
+                AddItem( gbritem );
 
                 if( m_SlotOn )  // Oblong hole
                 {
@@ -644,6 +607,7 @@ bool EXCELLON_IMAGE::Execute_EXCELLON_G_Command( char*& text )
     case DRILL_G_ZERO_SET:
         ReadXYCoord( text );
         m_Offset = m_CurrentPos;
+        InvalidateItemsIndex();
         break;
 
     case DRILL_G_ROUT:
@@ -26,15 +26,29 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif /* USE_OPENMP */
+
+#include <atomic>
+#include <wx/progdlg.h>
+
 #include <fctsys.h>
 #include <common.h>
+#include <confirm.h>
 #include <class_drawpanel.h>
+#include <html_messagebox.h>
 
 #include <gerbview_frame.h>
 #include <gerbview_id.h>
+#include <class_gerber_file_image.h>
+#include <class_gerber_file_image_list.h>
+#include <class_excellon.h>
 #include <class_gerbview_layer_widget.h>
 #include <wildcards_and_files_ext.h>
 
+#include <vector>
+
 
 void GERBVIEW_FRAME::OnGbrFileHistory( wxCommandEvent& event )
 {
@@ -170,8 +184,6 @@ bool GERBVIEW_FRAME::LoadGerberFiles( const wxString& aFullFileName )
     }
 
     // Read gerber files: each file is loaded on a new GerbView layer
-    int layer = getActiveLayer();
-
     for( unsigned ii = 0; ii < filenamesList.GetCount(); ii++ )
     {
         filename = filenamesList[ii];
@@ -179,35 +191,11 @@ bool GERBVIEW_FRAME::LoadGerberFiles( const wxString& aFullFileName )
         if( !filename.IsAbsolute() )
             filename.SetPath( currentPath );
 
-        m_lastFileName = filename.GetFullPath();
-
-        setActiveLayer( layer, false );
-
-        if( Read_GERBER_File( filename.GetFullPath() ) )
-        {
-            UpdateFileHistory( m_lastFileName );
-
-            layer = getNextAvailableLayer( layer );
-
-            if( layer == NO_AVAILABLE_LAYERS )
-            {
-                wxString msg = wxT( "No more empty available layers.\n"
-                                    "The remaining gerber files will not be loaded." );
-                wxMessageBox( msg );
-                break;
-            }
-
-            setActiveLayer( layer, false );
-        }
+        filenamesList[ii] = filename.GetFullPath();
     }
 
-    Zoom_Automatique( false );
+    LoadFileList( filenamesList, std::vector<bool>( filenamesList.GetCount(), false ) );
 
-    // Synchronize layers tools with actual active layer:
-    ReFillLayerWidget();
-    setActiveLayer( getActiveLayer() );
-    m_LayersManager->UpdateLayerIcons();
-    syncLayerBox();
     return true;
 }
 
@@ -253,9 +241,7 @@ bool GERBVIEW_FRAME::LoadExcellonFiles( const wxString& aFullFileName )
         m_mruPath = currentPath;
     }
 
-    // Read gerber files: each file is loaded on a new GerbView layer
-    int layer = getActiveLayer();
-
+    // Read drill files: each file is loaded on a new GerbView layer
     for( unsigned ii = 0; ii < filenamesList.GetCount(); ii++ )
     {
         filename = filenamesList[ii];
@@ -263,29 +249,170 @@ bool GERBVIEW_FRAME::LoadExcellonFiles( const wxString& aFullFileName )
         if( !filename.IsAbsolute() )
             filename.SetPath( currentPath );
 
-        m_lastFileName = filename.GetFullPath();
+        filenamesList[ii] = filename.GetFullPath();
+    }
+
+    LoadFileList( filenamesList, std::vector<bool>( filenamesList.GetCount(), true ) );
 
-        setActiveLayer( layer, false );
+    return true;
+}
+
+
+int GERBVIEW_FRAME::LoadFileList( const wxArrayString& aFullFileNames,
+                                  const std::vector<bool>& aIsDrillFile )
+{
+    int                 count = aFullFileNames.GetCount();
+    std::vector<GERBER_FILE_IMAGE*> images( count, (GERBER_FILE_IMAGE*) NULL );
+    std::vector<char>   success( count, 0 );    // not a vector<bool>: written by several threads
+    wxProgressDialog*   progressDialog = NULL;
+    std::atomic<int>    next( 0 );              // the next file to parse
+    std::atomic<int>    done( 0 );              // the count of parsed files
+    std::atomic<int>    lastDone( 0 );          // the last parsed file
+    wxString            msg;
+
+    if( count > 1 )
+        progressDialog = new wxProgressDialog( _( "Load Files" ), aFullFileNames[0],
+                                               count, this,
+                                               wxPD_AUTO_HIDE | wxPD_APP_MODAL |
+                                               wxPD_ELAPSED_TIME );
 
-        if( Read_EXCELLON_File( filename.GetFullPath() ) )
+    {
+        // The locale is switched once here: LOCALE_IO objects created at the same time
+        // by the parsers would race on it.
+        LOCALE_IO toggleIo;
+
+        // Each file is parsed in its own image, with no GERBVIEW_FRAME or
+        // GERBER_FILE_IMAGE_LIST access.
+        // Only the GUI thread (the master thread of the team) can update the dialog:
+        // when other threads parse the files, it only watches the count of parsed files,
+        // so the dialog follows the load even when a large file holds a thread.
+#ifdef USE_OPENMP
+        #pragma omp parallel
+#endif
         {
-            // Update the list of recent drill files.
-            UpdateFileHistory( filename.GetFullPath(),  &m_drillFileHistory );
+#ifdef USE_OPENMP
+            bool guiThread = omp_get_thread_num() == 0;
+            bool parser = !guiThread || omp_get_num_threads() == 1;
+#else
+            bool guiThread = true;
+            bool parser = true;
+#endif
+
+            while( parser )
+            {
+                int ii = next++;
+
+                if( ii >= count )
+                    break;
 
-            layer = getNextAvailableLayer( layer );
+                if( aIsDrillFile[ii] )
+                {
+                    EXCELLON_IMAGE* drill = new EXCELLON_IMAGE( 0 );
 
-            if( layer == NO_AVAILABLE_LAYERS )
+                    success[ii] = drill->LoadFile( aFullFileNames[ii] );
+                    images[ii] = drill;
+                }
+                else
+                {
+                    images[ii] = new GERBER_FILE_IMAGE( 0 );
+                    success[ii] = images[ii]->LoadGerberFile( aFullFileNames[ii] );
+                }
+
+                lastDone = ii;
+                done++;
+
+                if( progressDialog && guiThread )
+                    progressDialog->Update( done, aFullFileNames[ii] );
+            }
+
+            if( progressDialog && guiThread && !parser )
             {
-                wxString msg = wxT( "No more empty available layers.\n"
-                                    "The remaining gerber files will not be loaded." );
+                for( int current = done; current < count; current = done )
+                {
+                    progressDialog->Update( current, aFullFileNames[lastDone] );
+                    wxMilliSleep( 50 );
+                }
+            }
+        }
+    }
+
+    if( progressDialog )
+        progressDialog->Destroy();
+
+    // Add the images in file order, and report the problems of each file
+    GERBER_FILE_IMAGE_LIST* imagesList = GetImagesList();
+    int layer = getActiveLayer();
+    int loaded = 0;
+
+    for( int ii = 0; ii < count; ii++ )
+    {
+        const wxString& fullFileName = aFullFileNames[ii];
+        GERBER_FILE_IMAGE* image = images[ii];
+
+        m_lastFileName = fullFileName;
+
+        if( !success[ii] )
+        {
+            msg.Printf( _( "File <%s> not found" ), GetChars( fullFileName ) );
+            DisplayError( this, msg, 10 );
+            continue;
+        }
+
+        setActiveLayer( layer, false );
+
+        image->m_GraphicLayer = layer;
+        imagesList->DeleteImage( layer );
+        imagesList->AddGbrImage( image, layer );
+        images[ii] = NULL;
+        loaded++;
+
+        // Display errors list
+        if( image->GetMessages().size() > 0 )
+        {
+            HTML_MESSAGE_BOX dlg( this, aIsDrillFile[ii] ?
+                                  _( "Error reading EXCELLON drill file" ) : _( "Errors" ) );
+            dlg.ListSet( image->GetMessages() );
+            dlg.ShowModal();
+        }
+
+        if( aIsDrillFile[ii] )
+        {
+            // Update the list of recent drill files.
+            UpdateFileHistory( fullFileName, &m_drillFileHistory );
+        }
+        else
+        {
+            /* if the gerber file is only a RS274D file
+             * (i.e. without any aperture information), warn the user:
+             */
+            if( !image->m_Has_DCode )
+            {
+                msg = _( "Warning: this file has no D-Code definition\n"
+                         "It is perhaps an old RS274D file\n"
+                         "Therefore the size of items is undefined" );
                 wxMessageBox( msg );
-                break;
             }
 
-            setActiveLayer( layer, false );
+            UpdateFileHistory( fullFileName );
+        }
+
+        layer = getNextAvailableLayer( layer );
+
+        if( layer == NO_AVAILABLE_LAYERS )
+        {
+            msg = wxT( "No more empty available layers.\n"
+                       "The remaining gerber files will not be loaded." );
+            wxMessageBox( msg );
+            break;
         }
+
+        setActiveLayer( layer, false );
     }
 
+    // Delete the images which were not added to the list
+    for( int ii = 0; ii < count; ii++ )
+        delete images[ii];
+
     Zoom_Automatique( false );
 
     // Synchronize layers tools with actual active layer:
@@ -294,5 +421,5 @@ bool GERBVIEW_FRAME::LoadExcellonFiles( const wxString& aFullFileName )
     m_LayersManager->UpdateLayerIcons();
     syncLayerBox();
 
-    return true;
+    return loaded;
 }
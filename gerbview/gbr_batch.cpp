@@ -0,0 +1,410 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2016 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gbr_batch.cpp
+ */
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif /* USE_OPENMP */
+
+#include <fctsys.h>
+#include <common.h>
+#include <macros.h>
+#include <kiway.h>
+#include <reporter.h>
+#include <convert_to_biu.h>
+#include <wildcards_and_files_ext.h>
+
+#include <class_gerber_file_image.h>
+#include <class_excellon.h>
+#include <gbr_bitmap.h>
+#include <gbr_batch.h>
+
+#include <wx/filename.h>
+
+#include <memory>
+#include <new>
+
+
+/// The greatest number of regions reported for each layer
+#define MAX_REPORTED_REGIONS 20
+
+/// The greatest resolution of GBR_BATCH_OPTIONS::m_Dpi: a pixel of about 0.25 um
+#define MAX_BATCH_DPI 100000
+
+/// The greatest size of a layer bitmap, in bytes.  Each thread holds up to two of them.
+#define MAX_BITMAP_SIZE ( 256.0 * 1024 * 1024 )
+
+
+/**
+ * Function reportTime
+ * reports the time spent in \a aStep since \a aStart, and restarts \a aStart.
+ */
+static void reportTime( REPORTER& aReporter, const wxString& aStep, unsigned& aStart )
+{
+    unsigned now = GetRunningMicroSecs();
+
+    aReporter.Report( wxString::Format( wxT( "%s: %.1f ms" ), GetChars( aStep ),
+                                        ( now - aStart ) / 1000.0 ),
+                      REPORTER::RPT_INFO );
+    aStart = now;
+}
+
+
+/**
+ * Function loadImages
+ * reads \a aFiles concurrently in \a aImages, one image per file in the same order.
+ * The problems of each file are sent to \a aReporter.
+ * @return bool - false if a file could not be read
+ */
+static bool loadImages( const wxArrayString& aFiles,
+                        std::vector< std::unique_ptr<GERBER_FILE_IMAGE> >& aImages,
+                        REPORTER& aReporter )
+{
+    int                 count = aFiles.GetCount();
+    std::vector<char>   success( count, 0 );    // not a vector<bool>: written by several threads
+    bool                allLoaded = true;
+    wxString            msg;
+
+    aImages.resize( count );
+
+    {
+        // The locale is switched once here, see GERBVIEW_FRAME::LoadFileList()
+        LOCALE_IO toggleIo;
+
+#ifdef USE_OPENMP
+        #pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for( int ii = 0; ii < count; ii++ )
+        {
+            wxFileName fn( aFiles[ii] );
+
+            if( fn.GetExt().IsSameAs( DrillFileExtension, false ) )
+            {
+                EXCELLON_IMAGE* drill = new EXCELLON_IMAGE( ii );
+
+                success[ii] = drill->LoadFile( aFiles[ii] );
+                aImages[ii].reset( drill );
+            }
+            else
+            {
+                aImages[ii].reset( new GERBER_FILE_IMAGE( ii ) );
+                success[ii] = aImages[ii]->LoadGerberFile( aFiles[ii] );
+            }
+        }
+    }
+
+    for( int ii = 0; ii < count; ii++ )
+    {
+        if( !success[ii] )
+        {
+            msg.Printf( _( "File '%s' not found" ), GetChars( aFiles[ii] ) );
+            aReporter.Report( msg, REPORTER::RPT_ERROR );
+            allLoaded = false;
+            continue;
+        }
+
+        const wxArrayString& messages = aImages[ii]->GetMessages();
+
+        for( unsigned jj = 0; jj < messages.GetCount(); jj++ )
+        {
+            msg.Printf( wxT( "%s: %s" ), GetChars( aFiles[ii] ), GetChars( messages[jj] ) );
+            aReporter.Report( msg, REPORTER::RPT_WARNING );
+        }
+    }
+
+    return allLoaded;
+}
+
+
+/**
+ * Function mergeBoundingBoxes
+ * merges the bounding boxes of the items of \a aImages in \a aArea.
+ * @param aHasItems = true if \a aArea already holds a bounding box
+ * @return bool - false if there is still no item
+ */
+static bool mergeBoundingBoxes( std::vector< std::unique_ptr<GERBER_FILE_IMAGE> >& aImages,
+                                EDA_RECT& aArea, bool aHasItems )
+{
+    for( unsigned ii = 0; ii < aImages.size(); ii++ )
+    {
+        for( GERBER_DRAW_ITEM* item = aImages[ii]->GetItemsList(); item; item = item->Next() )
+        {
+            if( aHasItems )
+                aArea.Merge( item->GetBoundingBox() );
+            else
+                aArea = item->GetBoundingBox();
+
+            aHasItems = true;
+        }
+    }
+
+    return aHasItems;
+}
+
+
+GBR_BATCH_OPTIONS::GBR_BATCH_OPTIONS() :
+    m_Dpi( 1200 )
+{
+}
+
+
+int GbrBatchCompare( const GBR_BATCH_OPTIONS& aOptions, REPORTER& aReporter )
+{
+    std::vector< std::unique_ptr<GERBER_FILE_IMAGE> > images;
+    std::vector< std::unique_ptr<GERBER_FILE_IMAGE> > diffImages;
+    wxString    msg;
+    unsigned    start = GetRunningMicroSecs();
+    unsigned    step = start;
+    bool        compare = !aOptions.m_DiffFiles.IsEmpty();
+
+    if( aOptions.m_Dpi <= 0 || aOptions.m_Dpi > MAX_BATCH_DPI )
+    {
+        msg.Printf( _( "Invalid resolution %g dpi (greater than 0, up to %d dpi)" ),
+                    aOptions.m_Dpi, MAX_BATCH_DPI );
+        aReporter.Report( msg, REPORTER::RPT_ERROR );
+        return -1;
+    }
+
+    if( !loadImages( aOptions.m_Files, images, aReporter ) )
+        return -1;
+
+    if( compare && !loadImages( aOptions.m_DiffFiles, diffImages, aReporter ) )
+        return -1;
+
+    reportTime( aReporter, _( "Load files" ), step );
+
+    // Both job sets are rasterized on the same area, so their bitmaps can be compared
+    // pixel per pixel.  A small margin keeps the shapes away from the bitmap edges.
+    EDA_RECT    area;
+    bool        hasItems = mergeBoundingBoxes( images, area, false );
+
+    hasItems = mergeBoundingBoxes( diffImages, area, hasItems );
+
+    if( !hasItems )
+    {
+        aReporter.Report( _( "No item to rasterize" ), REPORTER::RPT_WARNING );
+        return 0;
+    }
+
+    area.Inflate( KiROUND( 0.1 * IU_PER_MM ) );
+
+    double bitmapSize = GBR_BITMAP::GetByteSize( area, aOptions.m_Dpi );
+
+    if( bitmapSize > MAX_BITMAP_SIZE )
+    {
+        msg.Printf( _( "The layers need %.0f MB bitmaps at %g dpi, more than %.0f MB: "
+                       "use a lower resolution" ),
+                    bitmapSize / ( 1024 * 1024 ), aOptions.m_Dpi,
+                    MAX_BITMAP_SIZE / ( 1024 * 1024 ) );
+        aReporter.Report( msg, REPORTER::RPT_ERROR );
+        return -1;
+    }
+
+    int layerCount = std::max( images.size(), diffImages.size() );
+
+    std::vector<long long>  pixelCounts( layerCount, 0 );
+    std::vector< std::vector<GBR_BITMAP_REGION> > regions( layerCount );
+    std::vector<char>       written( layerCount, 1 );
+    std::vector<char>       allocated( layerCount, 1 );
+
+    // A layer missing in one of the job sets is compared to an empty layer.  Each
+    // thread builds its own bitmaps: a layer needs up to two of them at a time.
+    // An exception must not leave the parallel loop: a failed allocation is only
+    // recorded, and reported after the loop.
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for( int layer = 0; layer < layerCount; layer++ )
+    {
+        try
+        {
+            GBR_BITMAP bitmap( area, aOptions.m_Dpi );
+
+            if( layer < (int) images.size() )
+                bitmap.DrawImage( images[layer].get() );
+
+            if( compare )
+            {
+                GBR_BITMAP other( area, aOptions.m_Dpi );
+
+                if( layer < (int) diffImages.size() )
+                    other.DrawImage( diffImages[layer].get() );
+
+                bitmap.Xor( other );
+            }
+
+            pixelCounts[layer] = bitmap.GetRegions( regions[layer] );
+
+            if( !aOptions.m_BitmapPrefix.IsEmpty() )
+            {
+                wxString filename = wxString::Format( wxT( "%s%d.pbm" ),
+                                                      GetChars( aOptions.m_BitmapPrefix ),
+                                                      layer + 1 );
+
+                written[layer] = bitmap.WritePBM( filename );
+            }
+        }
+        catch( const std::bad_alloc& )
+        {
+            allocated[layer] = 0;
+            regions[layer].clear();
+        }
+    }
+
+    reportTime( aReporter, compare ? _( "Compare layers" ) : _( "Rasterize layers" ), step );
+
+    int changedLayers = 0;
+    bool failed = false;
+
+    for( int layer = 0; layer < layerCount; layer++ )
+    {
+        const std::vector<GBR_BITMAP_REGION>& layerRegions = regions[layer];
+        const wxString& name = layer < (int) images.size() ? aOptions.m_Files[layer]
+                                                           : aOptions.m_DiffFiles[layer];
+
+        if( !allocated[layer] )
+        {
+            msg.Printf( _( "Layer %d (%s): not enough memory to rasterize it at %g dpi" ),
+                        layer + 1, GetChars( name ), aOptions.m_Dpi );
+            aReporter.Report( msg, REPORTER::RPT_ERROR );
+            failed = true;
+            continue;
+        }
+
+        if( !written[layer] )
+        {
+            msg.Printf( _( "Failed to create file '%s%d.pbm'." ),
+                        GetChars( aOptions.m_BitmapPrefix ), layer + 1 );
+            aReporter.Report( msg, REPORTER::RPT_ERROR );
+            failed = true;
+        }
+
+        if( compare && pixelCounts[layer] == 0 )
+        {
+            msg.Printf( _( "Layer %d (%s): no difference" ), layer + 1, GetChars( name ) );
+            aReporter.Report( msg, REPORTER::RPT_INFO );
+            continue;
+        }
+
+        if( compare )
+        {
+            msg.Printf( _( "Layer %d (%s): %lld different pixels in %d regions" ),
+                        layer + 1, GetChars( name ), pixelCounts[layer],
+                        (int) layerRegions.size() );
+            changedLayers++;
+        }
+        else
+        {
+            msg.Printf( _( "Layer %d (%s): %lld pixels in %d regions" ),
+                        layer + 1, GetChars( name ), pixelCounts[layer],
+                        (int) layerRegions.size() );
+        }
+
+        aReporter.Report( msg, compare ? REPORTER::RPT_WARNING : REPORTER::RPT_INFO );
+
+        // The regions are given in mm, in the gerber axis (Y axis bottom to top)
+        for( unsigned ii = 0; ii < layerRegions.size() && ii < MAX_REPORTED_REGIONS; ii++ )
+        {
+            const EDA_RECT& box = layerRegions[ii].m_Area;
+
+            msg.Printf( _( "    (%.3f, %.3f) to (%.3f, %.3f) mm: %lld pixels" ),
+                        box.GetX() / IU_PER_MM, -box.GetBottom() / IU_PER_MM,
+                        box.GetRight() / IU_PER_MM, -box.GetY() / IU_PER_MM,
+                        layerRegions[ii].m_PixelCount );
+            aReporter.Report( msg, REPORTER::RPT_INFO );
+        }
+
+        if( layerRegions.size() > MAX_REPORTED_REGIONS )
+        {
+            msg.Printf( _( "    and %d more regions" ),
+                        int( layerRegions.size() - MAX_REPORTED_REGIONS ) );
+            aReporter.Report( msg, REPORTER::RPT_INFO );
+        }
+    }
+
+    reportTime( aReporter, _( "Total" ), start );
+
+    return failed ? -1 : changedLayers;
+}
+
+
+int GbrBatchRun( KIWAY* aKiway, const std::vector<wxString>& aArgs )
+{
+    GBR_BATCH_OPTIONS   options;
+    CONSOLE_REPORTER    reporter;
+    wxString            msg;
+    bool                diffSet = false;    // true after "--diff": the next files are set B
+
+    for( unsigned ii = 0; ii < aArgs.size(); ii++ )
+    {
+        const wxString& arg = aArgs[ii];
+        bool            hasValue = ii + 1 < aArgs.size();
+
+        if( arg == wxT( "--dpi" ) && hasValue )
+        {
+            wxString value = aArgs[++ii];
+
+            if( !value.ToDouble( &options.m_Dpi ) )
+            {
+                msg.Printf( _( "Invalid resolution '%s'" ), GetChars( value ) );
+                reporter.Report( msg, REPORTER::RPT_ERROR );
+                return 2;
+            }
+        }
+        else if( arg == wxT( "--bitmap" ) && hasValue )
+            options.m_BitmapPrefix = aArgs[++ii];
+        else if( arg == wxT( "--diff" ) && !diffSet )
+            diffSet = true;
+        else if( !arg.StartsWith( wxT( "--" ) ) )
+        {
+            if( diffSet )
+                options.m_DiffFiles.Add( arg );
+            else
+                options.m_Files.Add( arg );
+        }
+        else
+        {
+            msg.Printf( _( "Invalid argument '%s'" ), GetChars( arg ) );
+            reporter.Report( msg, REPORTER::RPT_ERROR );
+            return 2;
+        }
+    }
+
+    if( options.m_Files.IsEmpty() || ( diffSet && options.m_DiffFiles.IsEmpty() ) )
+    {
+        reporter.Report( wxT( "usage: gerbview --batch [--dpi N] [--bitmap prefix]"
+                              " file... [--diff file...]" ),
+                         REPORTER::RPT_ERROR );
+        return 2;
+    }
+
+    int changedLayers = GbrBatchCompare( options, reporter );
+
+    if( changedLayers < 0 )
+        return 2;
+
+    return changedLayers ? 1 : 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2016 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gbr_batch.h
+ * @brief Gerber and drill files rasterized and compared from the command line,
+ * without a GerbView frame.
+ */
+
+#ifndef _GBR_BATCH_H_
+#define _GBR_BATCH_H_
+
+#include <vector>
+#include <wx/string.h>
+#include <wx/arrstr.h>
+
+
+class KIWAY;
+class REPORTER;
+
+
+/**
+ * Struct GBR_BATCH_OPTIONS
+ * describes what a GbrBatchCompare() job reads and writes.
+ */
+struct GBR_BATCH_OPTIONS
+{
+    wxArrayString   m_Files;                ///< the job set, one layer per file
+    wxArrayString   m_DiffFiles;            ///< empty: the job set is only rasterized
+    double          m_Dpi;                  ///< the rasterization resolution, up to 100000
+    wxString        m_BitmapPrefix;         ///< empty: no bitmap is written
+
+    GBR_BATCH_OPTIONS();
+};
+
+
+/**
+ * Function GbrBatchCompare
+ * loads the files of \a aOptions concurrently, rasterizes each layer in a
+ * GBR_BITMAP and, if a second job set is given, compares layer N of both sets.
+ * The changed regions and pixel counts of each layer, and the time spent in each
+ * step, are sent to \a aReporter.
+ *
+ * Files having the drill file extension are read as Excellon files, the other
+ * ones as Gerber files.
+ *
+ * @return int - the number of layers having differences, or -1 if a file could
+ *               not be read or written.
+ */
+int GbrBatchCompare( const GBR_BATCH_OPTIONS& aOptions, REPORTER& aReporter );
+
+
+/**
+ * Function GbrBatchRun
+ * is the gerbview KIFACE_BATCH_FUNC, run by "gerbview --batch ...":
+ * <pre>
+ * gerbview --batch [--dpi N] [--bitmap prefix] file... [--diff file...]
+ * </pre>
+ * With --bitmap, layer N is written in "prefixN.pbm", or its differences when
+ * --diff is given.
+ * @return int - 0 on success, 1 if the job sets differ, 2 if the job failed.
+ */
+int GbrBatchRun( KIWAY* aKiway, const std::vector<wxString>& aArgs );
+
+#endif  // _GBR_BATCH_H_
@@ -0,0 +1,529 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2016 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gbr_bitmap.cpp
+ */
+
+#include <fctsys.h>
+#include <common.h>
+#include <macros.h>
+#include <trigo.h>
+#include <convert_to_biu.h>
+#include <convert_basic_shapes_to_polygon.h>
+
+#include <class_gerber_file_image.h>
+#include <gbr_bitmap.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <string.h>
+
+
+#define SEGS_CNT 32     // number of segments to approximate a circle, as in dcode.cpp
+#define TILE_SIZE 64    // size in pixels of the tiles GetRegions() groups
+
+
+static inline int countBits( uint64_t aWord )
+{
+#if defined( __GNUC__ )
+    return __builtin_popcountll( aWord );
+#else
+    int count = 0;
+
+    for( ; aWord; count++ )
+        aWord &= aWord - 1;
+
+    return count;
+#endif
+}
+
+
+GBR_BITMAP::GBR_BITMAP( const EDA_RECT& aArea, double aDpi ) :
+    m_area( aArea )
+{
+    m_area.Normalize();
+
+    m_scale  = aDpi / ( IU_PER_MILS * 1000 );
+    m_width  = std::max( 1, KiROUND( m_area.GetWidth() * m_scale ) );
+    m_height = std::max( 1, KiROUND( m_area.GetHeight() * m_scale ) );
+    m_stride = ( ( m_width + TILE_SIZE - 1 ) / TILE_SIZE ) * ( TILE_SIZE / 8 );
+
+    m_bits.resize( (size_t) m_stride * m_height, 0 );
+}
+
+
+double GBR_BITMAP::GetByteSize( const EDA_RECT& aArea, double aDpi )
+{
+    // Same size as the constructor, computed in floating point so it cannot overflow
+    double scale  = aDpi / ( IU_PER_MILS * 1000 );
+    double width  = std::max( 1.0, floor( std::abs( aArea.GetWidth() ) * scale + 0.5 ) );
+    double height = std::max( 1.0, floor( std::abs( aArea.GetHeight() ) * scale + 0.5 ) );
+    double stride = ceil( width / TILE_SIZE ) * ( TILE_SIZE / 8 );
+
+    return stride * height;
+}
+
+
+void GBR_BITMAP::fillSpan( int aRow, int aStart, int aEnd, bool aSet )
+{
+    if( aStart < 0 )
+        aStart = 0;
+
+    if( aEnd >= m_width )
+        aEnd = m_width - 1;
+
+    if( aStart > aEnd )
+        return;
+
+    unsigned char* row   = &m_bits[ (size_t) aRow * m_stride ];
+    int            first = aStart >> 3;
+    int            last  = aEnd >> 3;
+    unsigned char  firstMask = 0xFF >> ( aStart & 7 );
+    unsigned char  lastMask  = ( 0xFF << ( 7 - ( aEnd & 7 ) ) ) & 0xFF;
+
+    if( first == last )
+    {
+        firstMask &= lastMask;
+        lastMask = firstMask;
+    }
+
+    if( aSet )
+    {
+        row[first] |= firstMask;
+
+        if( last > first + 1 )
+            memset( row + first + 1, 0xFF, last - first - 1 );
+
+        row[last] |= lastMask;
+    }
+    else
+    {
+        row[first] &= ~firstMask;
+
+        if( last > first + 1 )
+            memset( row + first + 1, 0, last - first - 1 );
+
+        row[last] &= ~lastMask;
+    }
+}
+
+
+void GBR_BITMAP::FillPolygon( const std::vector<wxPoint>& aCorners, bool aSet )
+{
+    struct EDGE
+    {
+        double  m_x;            ///< the edge X position at the center of the current row
+        double  m_dx;           ///< the X increment from one row to the next one
+        int     m_firstRow;
+        int     m_lastRow;
+
+        bool operator<( const EDGE& aOther ) const { return m_firstRow < aOther.m_firstRow; }
+    };
+
+    std::vector<EDGE>   edges;
+    int                 count = aCorners.size();
+
+    if( count < 3 )
+        return;
+
+    edges.reserve( count );
+
+    // Pixel centers are sampled: an edge from y0 to y1 crosses the rows whose center
+    // is in [y0, y1[, so two edges sharing a corner never count twice.
+    for( int ii = 0; ii < count; ii++ )
+    {
+        const wxPoint& p0 = aCorners[ii];
+        const wxPoint& p1 = aCorners[ ( ii + 1 ) % count ];
+
+        double x0 = ( p0.x - m_area.GetX() ) * m_scale;
+        double y0 = ( p0.y - m_area.GetY() ) * m_scale;
+        double x1 = ( p1.x - m_area.GetX() ) * m_scale;
+        double y1 = ( p1.y - m_area.GetY() ) * m_scale;
+
+        if( y0 == y1 )
+            continue;
+
+        if( y0 > y1 )
+        {
+            std::swap( x0, x1 );
+            std::swap( y0, y1 );
+        }
+
+        EDGE edge;
+
+        edge.m_firstRow = std::max( 0, (int) ceil( y0 - 0.5 ) );
+        edge.m_lastRow  = std::min( m_height - 1, (int) ceil( y1 - 0.5 ) - 1 );
+
+        if( edge.m_firstRow > edge.m_lastRow )
+            continue;
+
+        edge.m_dx = ( x1 - x0 ) / ( y1 - y0 );
+        edge.m_x  = x0 + ( edge.m_firstRow + 0.5 - y0 ) * edge.m_dx;
+        edges.push_back( edge );
+    }
+
+    if( edges.empty() )
+        return;
+
+    std::sort( edges.begin(), edges.end() );
+
+    std::vector<EDGE>   active;
+    std::vector<double> crossings;
+    unsigned            next = 0;
+
+    for( int row = edges[0].m_firstRow; next < edges.size() || !active.empty(); row++ )
+    {
+        // Drop the edges which ended above this row, add the ones starting on it
+        unsigned kept = 0;
+
+        for( unsigned ii = 0; ii < active.size(); ii++ )
+        {
+            if( active[ii].m_lastRow >= row )
+                active[kept++] = active[ii];
+        }
+
+        active.resize( kept );
+
+        while( next < edges.size() && edges[next].m_firstRow == row )
+            active.push_back( edges[next++] );
+
+        if( active.empty() )
+        {
+            if( next < edges.size() )
+                row = edges[next].m_firstRow - 1;
+
+            continue;
+        }
+
+        crossings.clear();
+
+        for( unsigned ii = 0; ii < active.size(); ii++ )
+        {
+            crossings.push_back( active[ii].m_x );
+            active[ii].m_x += active[ii].m_dx;
+        }
+
+        std::sort( crossings.begin(), crossings.end() );
+
+        // Even-odd rule: fill the pixels whose center is between two crossings
+        for( unsigned ii = 0; ii + 1 < crossings.size(); ii += 2 )
+        {
+            int start = (int) ceil( crossings[ii] - 0.5 );
+            int end   = (int) ceil( crossings[ii + 1] - 0.5 ) - 1;
+
+            fillSpan( row, start, end, aSet );
+        }
+    }
+}
+
+
+void GBR_BITMAP::FillPolySet( const SHAPE_POLY_SET& aPolySet, bool aSet )
+{
+    std::vector<wxPoint> corners;
+
+    for( int ii = 0; ii < aPolySet.OutlineCount(); ii++ )
+    {
+        const SHAPE_LINE_CHAIN& outline = aPolySet.COutline( ii );
+
+        corners.clear();
+
+        for( int jj = 0; jj < outline.PointCount(); jj++ )
+            corners.push_back( wxPoint( outline.CPoint( jj ).x, outline.CPoint( jj ).y ) );
+
+        FillPolygon( corners, aSet );
+    }
+}
+
+
+void GBR_BITMAP::DrawItem( GERBER_DRAW_ITEM* aItem )
+{
+    // Same polarity and shapes as GERBER_DRAW_ITEM::Draw(), in filled mode
+    bool            isDark = !( aItem->GetLayerPolarity() ^
+                                aItem->m_GerberImageFile->m_ImageNegative );
+    D_CODE*         dcode  = aItem->GetDcodeDescr();
+    SHAPE_POLY_SET  shape;
+    std::vector<wxPoint> corners;
+
+    switch( aItem->m_Shape )
+    {
+    case GBR_POLYGON:
+        corners = aItem->m_PolyCorners;
+
+        for( unsigned ii = 0; ii < corners.size(); ii++ )
+            corners[ii] = aItem->GetABPosition( corners[ii] );
+
+        FillPolygon( corners, isDark );
+        break;
+
+    case GBR_CIRCLE:
+        TransformRingToPolygon( shape, aItem->GetABPosition( aItem->m_Start ),
+                                KiROUND( GetLineLength( aItem->m_Start, aItem->m_End ) ),
+                                SEGS_CNT, aItem->m_Size.x );
+        FillPolySet( shape, isDark );
+        break;
+
+    case GBR_ARC:
+    {
+        // GRArc1() draws counter-clockwise on screen from the start point to the end point
+        wxPoint start  = aItem->GetABPosition( aItem->m_Start );
+        wxPoint end    = aItem->GetABPosition( aItem->m_End );
+        wxPoint center = aItem->GetABPosition( aItem->m_ArcCentre );
+        double  angle  = ArcTangente( start.y - center.y, start.x - center.x ) -
+                         ArcTangente( end.y - center.y, end.x - center.x );
+
+        NORMALIZE_ANGLE_POS( angle );
+
+        if( angle == 0 )
+            angle = 3600;
+
+        TransformArcToPolygon( shape, center, start, -angle, SEGS_CNT, aItem->m_Size.x );
+        FillPolySet( shape, isDark );
+    }
+        break;
+
+    case GBR_SEGMENT:
+        if( dcode && dcode->m_Shape == APT_RECT )
+        {
+            if( aItem->m_PolyCorners.size() == 0 )
+                aItem->ConvertSegmentToPolygon();
+
+            corners = aItem->m_PolyCorners;
+
+            for( unsigned ii = 0; ii < corners.size(); ii++ )
+                corners[ii] = aItem->GetABPosition( corners[ii] );
+
+            FillPolygon( corners, isDark );
+        }
+        else
+        {
+            TransformRoundedEndsSegmentToPolygon( shape, aItem->GetABPosition( aItem->m_Start ),
+                                                  aItem->GetABPosition( aItem->m_End ),
+                                                  SEGS_CNT, aItem->m_Size.x );
+            FillPolySet( shape, isDark );
+        }
+        break;
+
+    case GBR_SPOT_CIRCLE:
+    case GBR_SPOT_RECT:
+    case GBR_SPOT_OVAL:
+    case GBR_SPOT_POLY:
+        if( dcode == NULL )
+        {
+            // An undefined D_CODE is drawn as a round shape
+            TransformCircleToPolygon( shape, aItem->GetABPosition( aItem->m_Start ),
+                                      aItem->m_Size.x / 2, SEGS_CNT );
+            FillPolySet( shape, isDark );
+            break;
+        }
+
+        corners = dcode->GetFlashedPolygon();
+
+        for( unsigned ii = 0; ii < corners.size(); ii++ )
+            corners[ii] = aItem->GetABPosition( corners[ii] + aItem->m_Start );
+
+        FillPolygon( corners, isDark );
+        break;
+
+    case GBR_SPOT_MACRO:
+    {
+        if( dcode == NULL )
+            break;
+
+        const SHAPE_POLY_SET& macroShape = dcode->GetMacroShape( aItem );
+
+        for( int ii = 0; ii < macroShape.OutlineCount(); ii++ )
+        {
+            const SHAPE_LINE_CHAIN& outline = macroShape.COutline( ii );
+
+            corners.clear();
+
+            for( int jj = 0; jj < outline.PointCount(); jj++ )
+            {
+                wxPoint corner( outline.CPoint( jj ).x, outline.CPoint( jj ).y );
+
+                corners.push_back( aItem->GetABPosition( corner + aItem->m_Start ) );
+            }
+
+            FillPolygon( corners, isDark );
+        }
+    }
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void GBR_BITMAP::DrawImage( GERBER_FILE_IMAGE* aImage )
+{
+    for( GERBER_DRAW_ITEM* item = aImage->GetItemsList(); item; item = item->Next() )
+        DrawItem( item );
+}
+
+
+void GBR_BITMAP::Xor( const GBR_BITMAP& aOther )
+{
+    wxCHECK_RET( aOther.m_bits.size() == m_bits.size(),
+                 wxT( "GBR_BITMAP::Xor(): bitmaps of different sizes" ) );
+
+    // Rows are padded to 64 bits: compare 8 bytes at a time
+    for( size_t ii = 0; ii < m_bits.size(); ii += 8 )
+    {
+        uint64_t word, other;
+
+        memcpy( &word, &m_bits[ii], 8 );
+        memcpy( &other, &aOther.m_bits[ii], 8 );
+        word ^= other;
+        memcpy( &m_bits[ii], &word, 8 );
+    }
+}
+
+
+static bool sortByPixelCount( const GBR_BITMAP_REGION& aFirst, const GBR_BITMAP_REGION& aSecond )
+{
+    return aFirst.m_PixelCount > aSecond.m_PixelCount;
+}
+
+
+long long GBR_BITMAP::GetRegions( std::vector<GBR_BITMAP_REGION>& aRegions ) const
+{
+    int                     tileCols = m_stride / ( TILE_SIZE / 8 );
+    int                     tileRows = ( m_height + TILE_SIZE - 1 ) / TILE_SIZE;
+    std::vector<long long>  tileCount( (size_t) tileCols * tileRows, 0 );
+    long long               total = 0;
+
+    // A tile column is one 64 bit word of each row
+    for( int y = 0; y < m_height; y++ )
+    {
+        const unsigned char*    row   = &m_bits[ (size_t) y * m_stride ];
+        long long*              tiles = &tileCount[ (size_t) ( y / TILE_SIZE ) * tileCols ];
+
+        for( int col = 0; col < tileCols; col++ )
+        {
+            uint64_t word;
+
+            memcpy( &word, row + col * 8, 8 );
+
+            if( word )
+            {
+                int bits = countBits( word );
+
+                tiles[col] += bits;
+                total += bits;
+            }
+        }
+    }
+
+    // Merge the neighbour tiles having set pixels
+    std::vector<char>   visited( tileCount.size(), 0 );
+    std::vector<int>    stack;
+
+    for( int start = 0; start < (int) tileCount.size(); start++ )
+    {
+        if( !tileCount[start] || visited[start] )
+            continue;
+
+        int         minCol = tileCols, maxCol = -1;
+        int         minRow = tileRows, maxRow = -1;
+        long long   pixels = 0;
+
+        visited[start] = 1;
+        stack.push_back( start );
+
+        while( !stack.empty() )
+        {
+            int tile = stack.back();
+            int col  = tile % tileCols;
+            int row  = tile / tileCols;
+
+            stack.pop_back();
+
+            pixels += tileCount[tile];
+            minCol = std::min( minCol, col );
+            maxCol = std::max( maxCol, col );
+            minRow = std::min( minRow, row );
+            maxRow = std::max( maxRow, row );
+
+            for( int dy = -1; dy <= 1; dy++ )
+            {
+                for( int dx = -1; dx <= 1; dx++ )
+                {
+                    int ncol = col + dx;
+                    int nrow = row + dy;
+
+                    if( ncol < 0 || ncol >= tileCols || nrow < 0 || nrow >= tileRows )
+                        continue;
+
+                    int neighbour = nrow * tileCols + ncol;
+
+                    if( tileCount[neighbour] && !visited[neighbour] )
+                    {
+                        visited[neighbour] = 1;
+                        stack.push_back( neighbour );
+                    }
+                }
+            }
+        }
+
+        int x0 = minCol * TILE_SIZE;
+        int x1 = std::min( ( maxCol + 1 ) * TILE_SIZE, m_width );
+        int y0 = minRow * TILE_SIZE;
+        int y1 = std::min( ( maxRow + 1 ) * TILE_SIZE, m_height );
+
+        GBR_BITMAP_REGION region;
+
+        region.m_Area = EDA_RECT( wxPoint( m_area.GetX() + KiROUND( x0 / m_scale ),
+                                           m_area.GetY() + KiROUND( y0 / m_scale ) ),
+                                  wxSize( KiROUND( ( x1 - x0 ) / m_scale ),
+                                          KiROUND( ( y1 - y0 ) / m_scale ) ) );
+        region.m_PixelCount = pixels;
+        aRegions.push_back( region );
+    }
+
+    std::sort( aRegions.begin(), aRegions.end(), sortByPixelCount );
+
+    return total;
+}
+
+
+bool GBR_BITMAP::WritePBM( const wxString& aFullFileName ) const
+{
+    FILE* file = wxFopen( aFullFileName, wxT( "wb" ) );
+
+    if( file == NULL )
+        return false;
+
+    size_t  rowBytes = ( m_width + 7 ) / 8;
+    bool    success = fprintf( file, "P4\n%d %d\n", m_width, m_height ) > 0;
+
+    for( int y = 0; success && y < m_height; y++ )
+        success = fwrite( &m_bits[ (size_t) y * m_stride ], 1, rowBytes, file ) == rowBytes;
+
+    if( fclose( file ) != 0 )
+        success = false;
+
+    return success;
+}
@@ -0,0 +1,160 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2016 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gbr_bitmap.h
+ * @brief A monochrome bitmap to rasterize gerber images without any window.
+ */
+
+#ifndef GBR_BITMAP_H
+#define GBR_BITMAP_H
+
+#include <vector>
+
+#include <class_eda_rect.h>
+
+
+class wxString;
+class GERBER_FILE_IMAGE;
+class GERBER_DRAW_ITEM;
+class SHAPE_POLY_SET;
+
+
+/**
+ * Struct GBR_BITMAP_REGION
+ * is a group of neighbour set pixels of a GBR_BITMAP, see GBR_BITMAP::GetRegions().
+ */
+struct GBR_BITMAP_REGION
+{
+    EDA_RECT    m_Area;             ///< in GerbView internal units, A B axis
+    long long   m_PixelCount;       ///< the set pixels inside m_Area
+};
+
+
+/**
+ * Class GBR_BITMAP
+ * is a 1 bit per pixel bitmap covering an area of the A B (drawing) axis at a given
+ * resolution.  Gerber items are rasterized into it by a scanline polygon filler,
+ * dark items setting pixels and clear items resetting them, in the item list order.
+ *
+ * Pixels are packed 8 per byte, the leftmost pixel in the most significant bit, and
+ * each row is padded to a multiple of 64 pixels: spans are filled with memset()
+ * and whole bitmaps are compared 64 pixels at a time.
+ */
+class GBR_BITMAP
+{
+public:
+    /**
+     * Constructor
+     * @param aArea = the area covered by the bitmap, in internal units
+     * @param aDpi = the resolution, in pixels per inch
+     */
+    GBR_BITMAP( const EDA_RECT& aArea, double aDpi );
+
+    /**
+     * Function GetByteSize
+     * @return double - the memory size, in bytes, of a bitmap covering \a aArea at
+     *                  \a aDpi, so a caller can reject a too large bitmap before
+     *                  allocating it.
+     */
+    static double GetByteSize( const EDA_RECT& aArea, double aDpi );
+
+    int GetWidth() const                { return m_width; }
+    int GetHeight() const               { return m_height; }
+
+    /**
+     * Function GetPixel
+     * @return true if the pixel at column \a aX, row \a aY is set.
+     */
+    bool GetPixel( int aX, int aY ) const
+    {
+        return m_bits[ aY * m_stride + ( aX >> 3 ) ] & ( 0x80 >> ( aX & 7 ) );
+    }
+
+    /**
+     * Function DrawImage
+     * rasterizes all the items of \a aImage.
+     */
+    void DrawImage( GERBER_FILE_IMAGE* aImage );
+
+    /**
+     * Function DrawItem
+     * rasterizes \a aItem, with its own polarity.
+     */
+    void DrawItem( GERBER_DRAW_ITEM* aItem );
+
+    /**
+     * Function FillPolygon
+     * fills a polygon given in internal units with the even-odd rule.
+     * @param aSet = true to set the pixels inside the polygon, false to reset them
+     */
+    void FillPolygon( const std::vector<wxPoint>& aCorners, bool aSet );
+
+    /**
+     * Function FillPolySet
+     * fills each outline of \a aPolySet on its own (see FillPolygon()), so overlapping
+     * outlines are merged.  Holes must be fractured.
+     */
+    void FillPolySet( const SHAPE_POLY_SET& aPolySet, bool aSet );
+
+    /**
+     * Function Xor
+     * replaces this bitmap with the pixels which differ between this bitmap and
+     * \a aOther.  Both bitmaps must have the same size.
+     */
+    void Xor( const GBR_BITMAP& aOther );
+
+    /**
+     * Function GetRegions
+     * counts the set pixels and groups them in regions: the bitmap is split in tiles
+     * of 64 x 64 pixels, and tiles having set pixels are merged with their 8 neighbours.
+     * @param aRegions = a buffer to store the regions, largest pixel count first
+     * @return long long - the count of set pixels
+     */
+    long long GetRegions( std::vector<GBR_BITMAP_REGION>& aRegions ) const;
+
+    /**
+     * Function WritePBM
+     * writes the bitmap in the binary PBM ("P4") format, set pixels in black.
+     * @return bool - false if the file cannot be written
+     */
+    bool WritePBM( const wxString& aFullFileName ) const;
+
+private:
+    /**
+     * Function fillSpan
+     * sets or resets the pixels aStart to aEnd (included) of the row \a aRow, which
+     * must be inside the bitmap.  Columns outside the bitmap are clipped.
+     */
+    void fillSpan( int aRow, int aStart, int aEnd, bool aSet );
+
+    EDA_RECT                    m_area;
+    double                      m_scale;        ///< pixels per internal unit
+    int                         m_width;
+    int                         m_height;
+    int                         m_stride;       ///< bytes per row, a multiple of 8
+    std::vector<unsigned char>  m_bits;
+};
+
+
+#endif  // GBR_BITMAP_H
@@ -0,0 +1,265 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2016 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gbr_bitmap_test.cpp
+ * @brief Checks the GBR_BITMAP polygon filler, Xor() and GetRegions() on shapes
+ * whose pixels are known.  Build the gbr_bitmap_test target and run it: it
+ * prints the failed checks and returns 1 if any.
+ */
+
+#include <fctsys.h>
+#include <convert_to_biu.h>
+
+#include <gbr_bitmap.h>
+
+#include <stdio.h>
+
+
+#define TEST_DPI 100
+#define PIXEL ( IU_PER_MILS * 1000 / TEST_DPI )     // a pixel in internal units
+
+static int failures = 0;
+
+#define CHECK( cond ) check( cond, #cond, __LINE__ )
+
+
+static void check( bool aCondition, const char* aText, int aLine )
+{
+    if( !aCondition )
+    {
+        printf( "line %d: check failed: %s\n", aLine, aText );
+        failures++;
+    }
+}
+
+
+/// An area of \a aWidth x \a aHeight pixels at TEST_DPI
+static EDA_RECT pixelArea( int aWidth, int aHeight )
+{
+    return EDA_RECT( wxPoint( 0, 0 ), wxSize( KiROUND( aWidth * PIXEL ),
+                                              KiROUND( aHeight * PIXEL ) ) );
+}
+
+
+/// Fills the pixels [aX0, aX1[ x [aY0, aY1[ of \a aBitmap
+static void fillPixels( GBR_BITMAP& aBitmap, int aX0, int aY0, int aX1, int aY1,
+                        bool aSet = true )
+{
+    std::vector<wxPoint> corners;
+
+    corners.push_back( wxPoint( KiROUND( aX0 * PIXEL ), KiROUND( aY0 * PIXEL ) ) );
+    corners.push_back( wxPoint( KiROUND( aX1 * PIXEL ), KiROUND( aY0 * PIXEL ) ) );
+    corners.push_back( wxPoint( KiROUND( aX1 * PIXEL ), KiROUND( aY1 * PIXEL ) ) );
+    corners.push_back( wxPoint( KiROUND( aX0 * PIXEL ), KiROUND( aY1 * PIXEL ) ) );
+
+    aBitmap.FillPolygon( corners, aSet );
+}
+
+
+/// @return the count of set pixels, and false in aMatches if a pixel is set outside
+/// [aX0, aX1[ x [aY0, aY1[
+static int countPixels( const GBR_BITMAP& aBitmap, int aX0, int aY0, int aX1, int aY1,
+                        bool& aMatches )
+{
+    int count = 0;
+
+    aMatches = true;
+
+    for( int y = 0; y < aBitmap.GetHeight(); y++ )
+    {
+        for( int x = 0; x < aBitmap.GetWidth(); x++ )
+        {
+            if( !aBitmap.GetPixel( x, y ) )
+                continue;
+
+            count++;
+
+            if( x < aX0 || x >= aX1 || y < aY0 || y >= aY1 )
+                aMatches = false;
+        }
+    }
+
+    return count;
+}
+
+
+static void testSize()
+{
+    GBR_BITMAP bitmap( pixelArea( 100, 100 ), TEST_DPI );
+
+    CHECK( bitmap.GetWidth() == 100 );
+    CHECK( bitmap.GetHeight() == 100 );
+
+    // Rows are padded to 64 pixels
+    CHECK( GBR_BITMAP::GetByteSize( pixelArea( 100, 100 ), TEST_DPI ) == 16 * 100 );
+    CHECK( GBR_BITMAP::GetByteSize( pixelArea( 64, 10 ), TEST_DPI ) == 8 * 10 );
+
+    // Far too large to be allocated, but still computed
+    CHECK( GBR_BITMAP::GetByteSize( pixelArea( 100, 100 ), TEST_DPI * 1e6 ) > 1e15 );
+}
+
+
+static void testFill()
+{
+    GBR_BITMAP  bitmap( pixelArea( 100, 100 ), TEST_DPI );
+    bool        inside;
+
+    CHECK( countPixels( bitmap, 0, 0, 0, 0, inside ) == 0 );
+
+    fillPixels( bitmap, 10, 20, 30, 40 );
+    CHECK( countPixels( bitmap, 10, 20, 30, 40, inside ) == 20 * 20 );
+    CHECK( inside );
+
+    // A clear shape resets its pixels
+    fillPixels( bitmap, 15, 25, 25, 35, false );
+    CHECK( countPixels( bitmap, 10, 20, 30, 40, inside ) == 20 * 20 - 10 * 10 );
+    CHECK( inside );
+    CHECK( !bitmap.GetPixel( 20, 30 ) );
+    CHECK( bitmap.GetPixel( 12, 30 ) );
+
+    // A shape partly outside the bitmap is clipped, here to the last 4 columns
+    // and 6 rows
+    GBR_BITMAP clipped( pixelArea( 100, 100 ), TEST_DPI );
+
+    fillPixels( clipped, 96, -10, 120, 6 );
+    CHECK( countPixels( clipped, 96, 0, 100, 6, inside ) == 4 * 6 );
+    CHECK( inside );
+
+    // A triangle 8 pixels wide and 16 pixels high: the filler samples the pixel
+    // centers, so it has half of the 8 x 16 pixels
+    GBR_BITMAP              triangle( pixelArea( 100, 100 ), TEST_DPI );
+    std::vector<wxPoint>    corners;
+
+    corners.push_back( wxPoint( 0, 0 ) );
+    corners.push_back( wxPoint( KiROUND( 8 * PIXEL ), 0 ) );
+    corners.push_back( wxPoint( 0, KiROUND( 16 * PIXEL ) ) );
+    triangle.FillPolygon( corners, true );
+    CHECK( countPixels( triangle, 0, 0, 8, 16, inside ) == 8 * 16 / 2 );
+    CHECK( inside );
+}
+
+
+static void testXor()
+{
+    GBR_BITMAP  first( pixelArea( 100, 100 ), TEST_DPI );
+    GBR_BITMAP  second( pixelArea( 100, 100 ), TEST_DPI );
+    bool        inside;
+
+    fillPixels( first, 10, 20, 30, 40 );
+    fillPixels( second, 10, 20, 30, 40 );
+
+    // Same pixels: no difference
+    GBR_BITMAP same = first;
+
+    same.Xor( second );
+    CHECK( countPixels( same, 0, 0, 0, 0, inside ) == 0 );
+
+    // Only the hole differs
+    fillPixels( first, 15, 25, 25, 35, false );
+    first.Xor( second );
+    CHECK( countPixels( first, 15, 25, 25, 35, inside ) == 10 * 10 );
+    CHECK( inside );
+}
+
+
+static void testRegions()
+{
+    GBR_BITMAP                      bitmap( pixelArea( 300, 300 ), TEST_DPI );
+    std::vector<GBR_BITMAP_REGION>  regions;
+
+    CHECK( bitmap.GetRegions( regions ) == 0 );
+    CHECK( regions.empty() );
+
+    // Two shapes in tiles far apart, and one across 2 neighbour tiles
+    fillPixels( bitmap, 2, 2, 7, 7 );
+    fillPixels( bitmap, 200, 200, 210, 210 );
+    fillPixels( bitmap, 60, 130, 70, 140 );
+
+    CHECK( bitmap.GetRegions( regions ) == 25 + 100 + 100 );
+    CHECK( regions.size() == 3 );
+
+    if( regions.size() == 3 )
+    {
+        // Largest pixel count first; the two 100 pixel regions can be in any order
+        CHECK( regions[0].m_PixelCount == 100 );
+        CHECK( regions[1].m_PixelCount == 100 );
+        CHECK( regions[2].m_PixelCount == 25 );
+
+        // The area of a region is made of whole tiles, clipped to the bitmap
+        const EDA_RECT& tile = regions[2].m_Area;
+
+        CHECK( tile.GetX() == 0 && tile.GetY() == 0 );
+        CHECK( tile.GetWidth() == KiROUND( 64 * PIXEL ) );
+        CHECK( tile.GetHeight() == KiROUND( 64 * PIXEL ) );
+
+        const EDA_RECT& across = regions[0].m_Area.GetX() == 0 ? regions[0].m_Area
+                                                                : regions[1].m_Area;
+
+        CHECK( across.GetX() == 0 );
+        CHECK( across.GetY() == KiROUND( 128 * PIXEL ) );
+        CHECK( across.GetWidth() == KiROUND( 128 * PIXEL ) );
+        CHECK( across.GetHeight() == KiROUND( 64 * PIXEL ) );
+    }
+
+    // Shapes in neighbour tiles are merged in one region
+    GBR_BITMAP neighbours( pixelArea( 300, 300 ), TEST_DPI );
+
+    regions.clear();
+    fillPixels( neighbours, 10, 10, 20, 20 );
+    fillPixels( neighbours, 100, 100, 110, 110 );
+    CHECK( neighbours.GetRegions( regions ) == 200 );
+    CHECK( regions.size() == 1 );
+
+    // The last tile row and column are clipped to the bitmap size
+    GBR_BITMAP corner( pixelArea( 300, 300 ), TEST_DPI );
+
+    regions.clear();
+    fillPixels( corner, 290, 290, 300, 300 );
+    CHECK( corner.GetRegions( regions ) == 100 );
+
+    if( regions.size() == 1 )
+    {
+        CHECK( regions[0].m_Area.GetX() == KiROUND( 256 * PIXEL ) );
+        CHECK( regions[0].m_Area.GetRight() == KiROUND( 300 * PIXEL ) );
+        CHECK( regions[0].m_Area.GetBottom() == KiROUND( 300 * PIXEL ) );
+    }
+    else
+        CHECK( regions.size() == 1 );
+}
+
+
+int main( int argc, char** argv )
+{
+    testSize();
+    testFill();
+    testXor();
+    testRegions();
+
+    if( failures )
+        printf( "%d checks failed\n", failures );
+    else
+        printf( "all checks passed\n" );
+
+    return failures ? 1 : 0;
+}
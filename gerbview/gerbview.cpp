@@ -34,6 +34,7 @@
 #include <gerbview.h>
 #include <hotkeys.h>
 #include <gerbview_frame.h>
+#include <gbr_batch.h>
 
 // Colors for layers and items
 COLORS_DESIGN_SETTINGS g_ColorsSettings;
@@ -96,7 +97,14 @@ static struct IFACE : public KIFACE_I
      */
     void* IfaceOrAddress( int aDataId )
     {
-        return NULL;
+        switch( aDataId )
+        {
+        case KIFACE_ADDR_BATCH:
+            return (void*) &GbrBatchRun;
+
+        default:
+            return NULL;
+        }
     }
 
 } kiface( "gerbview", KIWAY::FACE_GERBVIEW );
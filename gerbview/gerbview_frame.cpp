@@ -210,22 +210,25 @@ bool GERBVIEW_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
         const unsigned limit = std::min( unsigned( aFileSet.size() ),
                                          unsigned( GERBER_DRAWLAYERS_COUNT ) );
 
-        int layer = 0;
+        wxArrayString       fullFileNames;
+        std::vector<bool>   isDrillFile;
 
-        for( unsigned i=0;  i<limit;  ++i, ++layer )
+        for( unsigned i=0;  i<limit;  ++i )
         {
-            setActiveLayer( layer );
+            wxFileName fn( aFileSet[i] );
+
+            fn.MakeAbsolute();
+            fullFileNames.Add( fn.GetFullPath() );
+            m_mruPath = fn.GetPath();
 
             // Try to guess the type of file by its ext
             // if it is .drl (Kicad files), it is a drill file
-            wxFileName fn( aFileSet[i] );
-            wxString ext = fn.GetExt();
-
-            if( ext == "drl" )
-                LoadExcellonFiles( aFileSet[i] );
-            else
-                LoadGerberFiles( aFileSet[i] );
+            isDrillFile.push_back( fn.GetExt() == "drl" );
         }
+
+        // The whole set is loaded at once, from layer 0
+        setActiveLayer( 0 );
+        LoadFileList( fullFileNames, isDrillFile );
     }
 
     Zoom_Automatique( true );        // Zoom fit in frame
@@ -583,10 +583,9 @@ public:
      * @return true if file was opened successfully.
      */
     bool                LoadGerberFiles( const wxString& aFileName );
-    bool                Read_GERBER_File( const wxString&   GERBER_FullFileName );
 
     /**
-     * function Read_EXCELLON_File
+     * function LoadExcellonFiles
      * Load a drill (EXCELLON) file or many files.
      * @param aFileName - void string or file name with full path to open or empty string to
      *                    open a new file. In this case one one file is loaded
@@ -594,7 +593,20 @@ public:
      * @return true if file was opened successfully.
      */
     bool                LoadExcellonFiles( const wxString& aFileName );
-    bool                Read_EXCELLON_File( const wxString& aFullFileName );
+
+    /**
+     * Function LoadFileList
+     * loads a set of Gerber and Excellon files.  The files are parsed concurrently,
+     * each one in a new image, and the images are then added to the images list in
+     * \a aFullFileNames order: the first one on the active layer, the next ones on the
+     * next available layers.  The errors found in a file are displayed when its image
+     * is added.
+     * @param aFullFileNames = the files to load, with full path
+     * @param aIsDrillFile = for each file, true for an Excellon file, false for a Gerber file
+     * @return int - the number of files actually loaded
+     */
+    int                 LoadFileList( const wxArrayString& aFullFileNames,
+                                      const std::vector<bool>& aIsDrillFile );
 
     bool                GeneralControl( wxDC* aDC, const wxPoint& aPosition, EDA_KEY aHotKey = 0 );
 
@@ -34,55 +34,10 @@
 #include <html_messagebox.h>
 #include <macros.h>
 
+#include <clocale>
+
 /* Read a gerber file, RS274D, RS274X or RS274X2 format.
  */
-bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
-{
-    wxString msg;
-
-    int layer = getActiveLayer();
-    GERBER_FILE_IMAGE_LIST* images = GetImagesList();
-    GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
-
-    if( gerber == NULL )
-    {
-        gerber = new GERBER_FILE_IMAGE( layer );
-        images->AddGbrImage( gerber, layer );
-    }
-
-    /* Read the gerber file */
-    bool success = gerber->LoadGerberFile( GERBER_FullFileName );
-
-    if( !success )
-    {
-        msg.Printf( _( "File <%s> not found" ), GetChars( GERBER_FullFileName ) );
-        DisplayError( this, msg, 10 );
-        return false;
-    }
-
-    // Display errors list
-    if( gerber->GetMessages().size() > 0 )
-    {
-        HTML_MESSAGE_BOX dlg( this, _("Errors") );
-        dlg.ListSet(gerber->GetMessages());
-        dlg.ShowModal();
-    }
-
-    /* if the gerber file is only a RS274D file
-     * (i.e. without any aperture information), wran the user:
-     */
-    if( !gerber->m_Has_DCode )
-    {
-        msg = _("Warning: this file has no D-Code definition\n"
-                "It is perhaps an old RS274D file\n"
-                "Therefore the size of items is undefined");
-        wxMessageBox( msg );
-    }
-
-    return true;
-}
-
-
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
     int      G_command = 0;        // command number for G commands like G04
@@ -90,6 +45,9 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     char     line[GERBER_BUFZ];
     char*    text;
 
+    // The numbers are read with strtod() and atof(): see LOCALE_IO in the caller
+    wxASSERT_MSG( *localeconv()->decimal_point == '.', wxT( "C locale expected" ) );
+
     ClearMessageList( );
     ResetDefaultValues();
 
@@ -101,14 +59,6 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     m_FileName = aFullFileName;
 
-    wxString path = wxPathOnly( aFullFileName );
-
-    // This change is needed to load included files, if exists:
-    if( path != wxEmptyString )
-        wxSetWorkingDirectory( path );
-
-    LOCALE_IO toggleIo;
-
     wxString msg;
 
     while( true )
@@ -337,8 +337,9 @@ static void fillArcPOLY(  GERBER_DRAW_ITEM* aGbrItem,
 {
     /* in order to calculate arc parameters, we use fillArcGBRITEM
      * so we muse create a dummy track and use its geometric parameters
+     * (not a static one: several files can be read at the same time)
      */
-    static GERBER_DRAW_ITEM dummyGbrItem( NULL );
+    GERBER_DRAW_ITEM dummyGbrItem( NULL );
 
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
@@ -547,6 +548,9 @@ bool GERBER_FILE_IMAGE::Execute_G_Command( char*& text, int G_command )
         if( m_Exposure && GetItemsList() )    // End of polygon
         {
             GERBER_DRAW_ITEM * gbritem = m_Drawings.GetLast();
+
+            // The corners were appended one by one: release the unused capacity
+            gbritem->m_PolyCorners.shrink_to_fit();
             StepAndRepeatItem( *gbritem );
         }
         m_Exposure = false;
@@ -609,7 +613,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
             {
                 m_Exposure = true;
                 gbritem    = new GERBER_DRAW_ITEM( this );
-                m_Drawings.Append( gbritem );
+                AddItem( gbritem );
                 gbritem->m_Shape = GBR_POLYGON;
                 gbritem->m_Flashed = false;
             }
@@ -638,6 +642,8 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
                 break;
             }
 
+            // The polygon outline has a new corner
+            InvalidateItemsIndex();
             m_PreviousPos = m_CurrentPos;
             m_PolygonFillModeState = 1;
             break;
@@ -646,6 +652,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
             if( m_Exposure && GetItemsList() )    // End of polygon
             {
                 gbritem = m_Drawings.GetLast();
+                gbritem->m_PolyCorners.shrink_to_fit();
                 StepAndRepeatItem( *gbritem );
             }
             m_Exposure    = false;
@@ -676,7 +683,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
             {
             case GERB_INTERPOL_LINEAR_1X:
                 gbritem = new GERBER_DRAW_ITEM( this );
-                m_Drawings.Append( gbritem );
+                AddItem( gbritem );
 
                 fillLineGBRITEM( gbritem, dcode, m_PreviousPos,
                                  m_CurrentPos, size, GetLayerParams().m_LayerNegative );
@@ -692,7 +699,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
             case GERB_INTERPOL_ARC_NEG:
             case GERB_INTERPOL_ARC_POS:
                 gbritem = new GERBER_DRAW_ITEM( this );
-                m_Drawings.Append( gbritem );
+                AddItem( gbritem );
 
                 fillArcGBRITEM( gbritem, dcode, m_PreviousPos,
                                 m_CurrentPos, m_IJPos, size,
@@ -726,7 +733,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
             }
 
             gbritem = new GERBER_DRAW_ITEM( this );
-            m_Drawings.Append( gbritem );
+            AddItem( gbritem );
             fillFlashedGBRITEM( gbritem, aperture, dcode, m_CurrentPos,
                                 size, GetLayerParams().m_LayerNegative );
             StepAndRepeatItem( *gbritem );
@@ -35,6 +35,8 @@
 #include <class_gerber_file_image.h>
 #include <class_X2_gerber_attributes.h>
 
+#include <wx/filename.h>
+
 extern int ReadInt( char*& text, bool aSkipSeparator = true );
 extern double ReadDouble( char*& text, bool aSkipSeparator = true );
 extern bool GetEndOfBlock( char* buff, char*& text, FILE* gerber_file );
@@ -311,6 +313,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int command, char* buff, char*& te
         m_SwapAxis = false;
         if( strnicmp( text, "AYBX", 4 ) == 0 )
             m_SwapAxis = true;
+        InvalidateItemsIndex();
         break;
 
     case MIRROR_IMAGE:      // command %MIA0B0*%, %MIA0B1*%, %MIA1B0*%, %MIA1B1*%
@@ -336,6 +339,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int command, char* buff, char*& te
                 break;
             }
         }
+        InvalidateItemsIndex();
         break;
 
     case MODE_OF_UNITS:
@@ -387,6 +391,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int command, char* buff, char*& te
                 break;
             }
         }
+        InvalidateItemsIndex();
         break;
 
     case SCALE_FACTOR:
@@ -406,6 +411,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int command, char* buff, char*& te
                 break;
             }
         }
+        InvalidateItemsIndex();
         break;
 
     case IMAGE_OFFSET:  // command: IOAnnBnn (nn = float number) = Image Offset
@@ -427,6 +433,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int command, char* buff, char*& te
                 break;
             }
         }
+        InvalidateItemsIndex();
         break;
 
     case IMAGE_ROTATION:    // command IR0* or IR90* or IR180* or IR270*
@@ -440,6 +447,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int command, char* buff, char*& te
             m_ImageRotation = 270;
         else
             AddMessageToList( _( "RS274X: Command \"IR\" rotation value not allowed" ) );
+        InvalidateItemsIndex();
         break;
 
     case STEP_AND_REPEAT:   // command SR, like %SRX3Y2I5.0J2*%
@@ -526,6 +534,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int command, char* buff, char*& te
             m_ImageJustifyOffset.x = 0;
         if( m_ImageJustifyYCenter )
             m_ImageJustifyOffset.y = 0;
+        InvalidateItemsIndex();
         break;
 
     case KNOCKOUT:
@@ -548,6 +557,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int command, char* buff, char*& te
     case ROTATE:        // Layer rotation: command like %RO45*%
         m_Iterpolation = GERB_INTERPOL_LINEAR_1X;       // Start a new Gerber layer
         m_LocalRotation =ReadDouble( text );             // Store layer rotation in degrees
+        InvalidateItemsIndex();
         break;
 
     case IMAGE_NAME:
@@ -603,7 +613,17 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int command, char* buff, char*& te
         strtok( line, "*%%\n\r" );
         m_FilesList[m_FilesPtr] = m_Current_File;
 
-        m_Current_File = fopen( line, "rt" );
+        {
+            // A relative include file name is relative to the main file path.
+            // The working directory is not changed: several files can be read at once.
+            wxFileName includeFile( FROM_UTF8( line ) );
+
+            if( !includeFile.IsAbsolute() )
+                includeFile.MakeAbsolute( wxPathOnly( m_FileName ) );
+
+            m_Current_File = wxFopen( includeFile.GetFullPath(), wxT( "rt" ) );
+        }
+
         if( m_Current_File == 0 )
         {
             msg.Printf( wxT( "include file <%s> not found." ), line );
@@ -160,4 +160,10 @@ private:
 
 extern BASIC_GAL basic_gal;
 
+// Texts are plotted by several threads at once (see PlotBoardLayers()), and
+// basic_gal holds the attributes of the text being drawn: each thread has its own.
+#ifdef USE_OPENMP
+    #pragma omp threadprivate( basic_gal )
+#endif
+
 #endif      // define BASIC_GAL_H
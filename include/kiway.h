@@ -155,6 +155,8 @@ struct KIFACE
 #define KFCTL_CPP_PROJECT_SUITE (1<<1)  ///< Am running under C++ project mgr, possibly with others
 #define KFCTL_PY_PROJECT_SUITE  (1<<2)  ///< Am running under python project mgr, possibly with others
 
+#define KIFACE_ADDR_BATCH       1       ///< IfaceOrAddress() id of a KIFACE_BATCH_FUNC
+
 
     /**
      * Function OnKifaceStart
@@ -444,6 +446,18 @@ extern KIWAY Kiway;     // provided by single_top.cpp and kicad.cpp
  */
 typedef     KIFACE*  KIFACE_GETTER_FUNC( int* aKIFACEversion, int aKIWAYversion, PGM_BASE* aProgram );
 
+/**
+ * Function Pointer KIFACE_BATCH_FUNC
+ * points to a KIFACE function which runs a job described on the command line
+ * without opening any window, as returned by IfaceOrAddress( KIFACE_ADDR_BATCH ).
+ * A KIFACE which has no batch jobs returns NULL for this id.
+ *
+ * @param aKiway is the KIWAY giving access to the PROJECT.
+ * @param aArgs are the command line arguments following the "--batch" option.
+ * @return int - the process exit code.
+ */
+typedef     int  KIFACE_BATCH_FUNC( KIWAY* aKiway, const std::vector<wxString>& aArgs );
+
 /// No name mangling.  Each KIFACE (DSO/DLL) will implement this once.
 extern "C" {
 
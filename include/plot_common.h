@@ -33,12 +33,15 @@
 #define PLOT_COMMON_H_
 
 #include <vector>
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
 #include <math/box2.h>
 #include <drawtxt.h>
 #include <class_page_info.h>
 #include <eda_text.h>       // FILL_T
 
 class SHAPE_POLY_SET;
+class SHAPE_LINE_CHAIN;
 
 /**
  * Enum PlotFormat
@@ -76,6 +79,41 @@ enum PlotTextMode {
 };
 
 
+/**
+ * Class PLOT_CORNERS
+ * gives the same access to the corners of a polygon stored in a std::vector<wxPoint>
+ * or in a SHAPE_LINE_CHAIN, so that a plotter plots both with the same code.
+ * A chain is the outline of a polygon: if it does not end with its first corner,
+ * the first corner is given again at the end.
+ */
+class PLOT_CORNERS
+{
+public:
+    PLOT_CORNERS( const std::vector< wxPoint >& aCornerList ) :
+        m_cornerList( &aCornerList ),
+        m_chain( NULL ),
+        m_count( aCornerList.size() )
+    {
+    }
+
+    PLOT_CORNERS( const SHAPE_LINE_CHAIN& aChain );
+
+    int Count() const { return m_count; }
+
+    wxPoint operator[]( int aIndex ) const
+    {
+        return m_cornerList ? (*m_cornerList)[aIndex] : chainCorner( aIndex );
+    }
+
+private:
+    wxPoint chainCorner( int aIndex ) const;
+
+    const std::vector< wxPoint >*   m_cornerList;
+    const SHAPE_LINE_CHAIN*         m_chain;
+    int                             m_count;
+};
+
+
 /**
  * Base plotter engine class. General rule: all the interface with the caller
  * is done in IU, the IU size is specified with SetViewport. Internal and
@@ -251,6 +289,21 @@ public:
     virtual void PlotPoly( const std::vector< wxPoint >& aCornerList, FILL_T aFill,
                int aWidth = USE_DEFAULT_LINE_WIDTH ) = 0;
 
+    /**
+     * Function PlotPoly
+     * @brief Draw a polygon ( filled or not ) given by a SHAPE_LINE_CHAIN,
+     * for instance an outline of a SHAPE_POLY_SET.  The polygon is always closed,
+     * like a corners list ending with its first corner, even if the chain is not
+     * flagged as closed.
+     * This default implementation copies the corners in a std::vector; the other
+     * plotters read them from the chain, like their corners lists (see PLOT_CORNERS).
+     * @param aCornerList = corners list
+     * @param aFill = type of fill
+     * @param aWidth = line width
+     */
+    virtual void PlotPoly( const SHAPE_LINE_CHAIN& aCornerList, FILL_T aFill,
+               int aWidth = USE_DEFAULT_LINE_WIDTH );
+
     /**
      * Function PlotImage
      * Only Postscript plotters can plot bitmaps
@@ -373,6 +426,16 @@ public:
         // NOP for most plotters. Only for Gerber plotter
     }
 
+    /**
+     * Function formatInt
+     * writes the decimal text of \a aValue, like "%d" but without the format
+     * parsing of printf: coordinates are the bulk of the plot files.
+     * @param aBuffer = the destination, at least 11 chars long
+     * @param aValue = the value to write
+     * @return the end of the written text (it is not null terminated)
+     */
+    static char* formatInt( char* aBuffer, int aValue );
+
 protected:
     // These are marker subcomponents
     /**
@@ -445,6 +508,16 @@ protected:
 
     double GetDashGapLenIU() const;
 
+    /**
+     * Function setFileBuffer
+     * gives a plot file a large stdio buffer: the plotters write a lot of short
+     * lines, which the default buffer flushes every few KB.
+     * Must be called after opening \a aFile and before writing to it.
+     * @param aFile = the plot file
+     * @param aBuffer = the buffer used by aFile, must be kept until aFile is closed
+     */
+    static void setFileBuffer( FILE* aFile, std::vector<char>& aBuffer );
+
 protected:      // variables used in most of plotters:
     /// Plot scale - chosen by the user (even implicitly with 'fit in a4')
     double        plotScale;
@@ -470,6 +543,9 @@ protected:      // variables used in most of plotters:
     /// Output file
     FILE*         outputFile;
 
+    /// The stdio buffer of outputFile (see setFileBuffer())
+    std::vector<char> m_outputBuffer;
+
     // Pen handling
     bool          colorMode;        /// true to plot in color, false to plot in black and white
     bool          negativeMode;     /// true to generate a negative image (PS mode mainly)
@@ -539,6 +615,8 @@ public:
                          int width = USE_DEFAULT_LINE_WIDTH );
     virtual void PlotPoly( const std::vector< wxPoint >& aCornerList,
                            FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH);
+    virtual void PlotPoly( const SHAPE_LINE_CHAIN& aCornerList,
+                           FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH );
 
     virtual void ThickSegment( const wxPoint& start, const wxPoint& end, int width,
                                EDA_DRAW_MODE_T tracemode );
@@ -561,6 +639,9 @@ public:
                                  double aPadOrient, EDA_DRAW_MODE_T aTrace_Mode );
 
 protected:
+    /// The body of both PlotPoly(): plots a corners list or a SHAPE_LINE_CHAIN
+    void plotCorners( const PLOT_CORNERS& aCorners, FILL_T aFill, int aWidth );
+
     void penControl( char plume );
 
     int    penSpeed;
@@ -699,6 +780,8 @@ public:
 
     virtual void PlotPoly( const std::vector< wxPoint >& aCornerList,
                            FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH );
+    virtual void PlotPoly( const SHAPE_LINE_CHAIN& aCornerList,
+                           FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH );
 
     virtual void PlotImage( const wxImage& aImage, const wxPoint& aPos,
                             double aScaleFactor );
@@ -716,13 +799,15 @@ public:
                        bool                        aBold,
                        bool                        aMultilineAllowed = false );
 protected:
+    void plotCorners( const PLOT_CORNERS& aCorners, FILL_T aFill, int aWidth );
+
     virtual void emitSetRGBColor( double r, double g, double b );
 };
 
 class PDF_PLOTTER : public PSLIKE_PLOTTER
 {
 public:
-    PDF_PLOTTER() : pageStreamHandle( 0 ), workFile( NULL )
+    PDF_PLOTTER() : pageStreamHandle( 0 ), workFile( NULL ), pendingStreamsSize( 0 )
     {
         // Avoid non initialized variables:
         pageStreamHandle = streamLengthHandle = fontResDictHandle = 0;
@@ -770,6 +855,8 @@ public:
 
     virtual void PlotPoly( const std::vector< wxPoint >& aCornerList,
                            FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH);
+    virtual void PlotPoly( const SHAPE_LINE_CHAIN& aCornerList,
+                           FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH );
 
     virtual void PenTo( const wxPoint& pos, char plume );
 
@@ -790,12 +877,15 @@ public:
 
 
 protected:
+    void plotCorners( const PLOT_CORNERS& aCorners, FILL_T aFill, int aWidth );
+
     virtual void emitSetRGBColor( double r, double g, double b );
     int allocPdfObject();
     int startPdfObject(int handle = -1);
     void closePdfObject();
     int startPdfStream(int handle = -1);
     void closePdfStream();
+    void flushPdfStreams();
     int pageTreeHandle;		 /// Handle to the root of the page tree object
     int fontResDictHandle;	 /// Font resource dictionary
     std::vector<int> pageHandles;/// Handles to the page objects
@@ -803,7 +893,19 @@ protected:
     int streamLengthHandle;      /// Handle to the deferred stream length
     wxString workFilename;
     FILE* workFile;  	         /// Temporary file to costruct the stream before zipping
+    std::vector<char> workBuffer;  /// The stdio buffer of workFile
     std::vector<long> xrefTable; /// The PDF xref offset table
+
+    /// A closed stream, waiting to be compressed and written by flushPdfStreams()
+    struct PENDING_STREAM
+    {
+        int handle;                  /// Handle of the stream object
+        int lengthHandle;            /// Handle of its deferred length
+        std::vector<char> data;      /// The stream content, compressed when flushed
+    };
+
+    std::vector<PENDING_STREAM> pendingStreams;
+    size_t pendingStreamsSize;   /// Uncompressed size of pendingStreams
 };
 
 class SVG_PLOTTER : public PSLIKE_PLOTTER
@@ -838,6 +940,8 @@ public:
 
     virtual void PlotPoly( const std::vector< wxPoint >& aCornerList,
                            FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH );
+    virtual void PlotPoly( const SHAPE_LINE_CHAIN& aCornerList,
+                           FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH );
 
     virtual void PlotImage( const wxImage& aImage, const wxPoint& aPos,
                             double aScaleFactor );
@@ -856,6 +960,8 @@ public:
                        bool                        aMultilineAllowed = false );
 
 protected:
+    void plotCorners( const PLOT_CORNERS& aCorners, FILL_T aFill, int aWidth );
+
     FILL_T m_fillMode;              // true if the current contour
                                     // rect, arc, circle, polygon must be filled
     long m_pen_rgb_color;           // current rgb color value: each color has
@@ -954,9 +1060,19 @@ public:
      */
     virtual void PlotPoly( const std::vector< wxPoint >& aCornerList,
                            FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH );
+    virtual void PlotPoly( const SHAPE_LINE_CHAIN& aCornerList,
+                           FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH );
 
     virtual void PenTo( const wxPoint& pos, char plume );
 
+    /**
+     * Function PlotRegions
+     * plots all the outlines of \a aPolygons as the contours of a single G36/G37
+     * region, without thick outline.  The polygons must be fractured (no holes)
+     * like the filled areas of zones.
+     */
+    void PlotRegions( const SHAPE_POLY_SET& aPolygons );
+
     /**
      * Filled circular flashes are stored as apertures
      */
@@ -1015,6 +1131,8 @@ public:
     virtual void SetGerberCoordinatesFormat( int aResolution, bool aUseInches = false );
 
 protected:
+    void plotCorners( const PLOT_CORNERS& aCorners, FILL_T aFill, int aWidth );
+
     void selectAperture( const wxSize& size, APERTURE::APERTURE_TYPE type );
 
     /**
@@ -1030,6 +1148,7 @@ protected:
     FILE* workFile;
     FILE* finalFile;
     wxString m_workFilename;
+    std::vector<char> m_workBuffer;     ///< the stdio buffer of workFile
 
     /**
      * Generate the table of D codes
@@ -1039,6 +1158,24 @@ protected:
     std::vector<APERTURE>           apertures;
     std::vector<APERTURE>::iterator currentAperture;
 
+    /// The type and size of an aperture
+    typedef std::pair<APERTURE::APERTURE_TYPE, wxSize> APERTURE_KEY;
+
+    struct APERTURE_KEY_HASH
+    {
+        std::size_t operator()( const APERTURE_KEY& aKey ) const
+        {
+            std::size_t seed = aKey.first;
+
+            boost::hash_combine( seed, aKey.second.x );
+            boost::hash_combine( seed, aKey.second.y );
+            return seed;
+        }
+    };
+
+    /// The index in apertures of each aperture, used by getAperture()
+    boost::unordered_map<APERTURE_KEY, unsigned, APERTURE_KEY_HASH> m_apertureIndex;
+
     bool     m_gerberUnitInch;  // true if the gerber units are inches, false for mm
     int      m_gerberUnitFmt;   // number of digits in mantissa.
                                 // usually 6 in Inches and 5 or 6  in mm
@@ -1100,6 +1237,10 @@ public:
                          int width = USE_DEFAULT_LINE_WIDTH );
     virtual void PlotPoly( const std::vector< wxPoint >& aCornerList,
                            FILL_T aFill, int aWidth = USE_DEFAULT_LINE_WIDTH );
+
+    // The SHAPE_LINE_CHAIN version is the one of PLOTTER
+    using PLOTTER::PlotPoly;
+
     virtual void ThickSegment( const wxPoint& start, const wxPoint& end, int width,
                                EDA_DRAW_MODE_T tracemode );
     virtual void Arc( const wxPoint& centre, double StAngle, double EndAngle,
@@ -146,6 +146,22 @@ public:
     REPORTER& Report( const wxString& aText, SEVERITY aSeverity = RPT_UNDEFINED );
 };
 
+/**
+ * Class CONSOLE_REPORTER
+ * writes the messages to stdout, and the errors to stderr.  Used by the batch jobs,
+ * which run without any window.
+ */
+class CONSOLE_REPORTER : public REPORTER
+{
+public:
+    CONSOLE_REPORTER() :
+        REPORTER()
+    {
+    }
+
+    REPORTER& Report( const wxString& aText, SEVERITY aSeverity = RPT_UNDEFINED );
+};
+
 /**
  * Class NULL_REPORTER
  *
@@ -462,7 +462,8 @@ public:
 
     /**
      * Function RecacheAllItems()
-     * Rebuilds GAL display lists.
+     * Rebuilds GAL display lists. Items are only redrawn, they keep their place in the
+     * spatial index of the layers.
      */
     void RecacheAllItems();
 
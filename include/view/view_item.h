@@ -65,6 +65,8 @@ public:
      * - COLOR:
      * - GEOMETRY: shape or layer set of the item have changed, VIEW may need to reindex it.
      * - LAYERS: TODO
+     * - REPAINT: the cached drawing has to be regenerated, but the shape and layer set
+     * of the item are the same, so it does not need to be reindexed.
      * - ALL: all the flags above */
 
     enum VIEW_UPDATE_FLAGS {
@@ -73,6 +75,7 @@ public:
         COLOR       = 0x02,     /// Color has changed
         GEOMETRY    = 0x04,     /// Position or shape has changed
         LAYERS      = 0x08,     /// Layers have changed
+        REPAINT     = 0x10,     /// Cached drawing has to be regenerated
         ALL         = 0xff
     };
 
@@ -54,6 +54,11 @@ static int s_textWidth;
 static int s_textCircle2SegmentCount;
 static SHAPE_POLY_SET* s_cornerBuffer;
 
+// Board layers can be converted by several threads at once (see PlotBoardLayers()).
+#ifdef USE_OPENMP
+    #pragma omp threadprivate( s_textWidth, s_textCircle2SegmentCount, s_cornerBuffer )
+#endif
+
 // This is a call back function, used by DrawGraphicText to draw the 3D text shape:
 static void addTextSegmToPoly( int x0, int y0, int xf, int yf )
 {
@@ -650,6 +650,8 @@ void DIALOG_PLOT::applyPlotSettings()
 
     tempOptions.SetUseGerberProtelExtensions( m_useGerberExtensions->GetValue() );
     tempOptions.SetUseGerberAttributes( m_useGerberAttributes->GetValue() );
+    // Not shown in the dialog: set in the board file or by a script
+    tempOptions.SetUseGerberRegions( m_plotOpts.GetUseGerberRegions() );
     tempOptions.SetGerberPrecision( m_rbGerberFormat->GetSelection() == 0 ? 5 : 6 );
 
     LSET selectedLayers;
@@ -759,6 +761,8 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
 
     wxBusyCursor dummy;
 
+    std::vector<PLOT_JOB> jobs;
+
     for( LSEQ seq = m_plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
     {
         LAYER_ID layer = *seq;
@@ -784,26 +788,29 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
                            m_board->GetLayerName( layer ),
                            file_ext );
 
+        jobs.push_back( PLOT_JOB( layer, m_plotOpts.GetFormat(), fn.GetFullPath() ) );
+    }
+
+    // The layers are plotted concurrently, the messages are printed in the layer order.
+    {
         LOCALE_IO toggle;
 
-        BOARD*      board = m_parent->GetBoard();
-        PLOTTER*    plotter = StartPlotBoard( board, &m_plotOpts, layer, fn.GetFullPath(), wxEmptyString );
+        PlotBoardLayers( m_parent->GetBoard(), m_plotOpts, jobs );
+    }
 
+    for( unsigned ii = 0; ii < jobs.size(); ii++ )
+    {
         // Print diags in messages box:
         wxString msg;
 
-        if( plotter )
+        if( jobs[ii].m_Plotted )
         {
-            PlotOneBoardLayer( board, plotter, layer, m_plotOpts );
-            plotter->EndPlot();
-            delete plotter;
-
-            msg.Printf( _( "Plot file '%s' created." ), GetChars( fn.GetFullPath() ) );
+            msg.Printf( _( "Plot file '%s' created." ), GetChars( jobs[ii].m_FileName ) );
             reporter.Report( msg, REPORTER::RPT_ACTION );
         }
         else
         {
-            msg.Printf( _( "Unable to create file '%s'." ), GetChars( fn.GetFullPath() ) );
+            msg.Printf( _( "Unable to create file '%s'." ), GetChars( jobs[ii].m_FileName ) );
             reporter.Report( msg, REPORTER::RPT_ERROR );
         }
     }
@@ -50,6 +50,7 @@
 #include "../3d-viewer/modelparsers.h"
 
 #include <vector>
+#include <map>
 #include <cmath>
 #include <vrml_layer.h>
 
@@ -162,6 +163,12 @@ public:
     LAYER_NUM s_text_layer;
     int s_text_width;
 
+    // Names of the DEF'd Inline nodes of the 3D models already written, keyed by the
+    // full path of the model file. Further placements of a model are written as a USE
+    // of its node so viewers load the geometry once. An empty name marks a model which
+    // could not be exported.
+    std::map< wxString, std::string > modelNodes;
+
     MODEL_VRML()
     {
         for( unsigned i = 0; i < DIM( layer_z );  ++i )
@@ -1206,10 +1213,26 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb, MODULE* aModule
         wxFileName modelFileName = vrmlm->GetShape3DFullFilename();
         wxFileName destFileName( a3D_Subdir, modelFileName.GetName(), modelFileName.GetExt() );
 
+        // The file checks and the copy are only done for the first placement of a model
+        std::map< wxString, std::string >::iterator node =
+                aModel.modelNodes.find( modelFileName.GetFullPath() );
+        bool firstInstance = ( node == aModel.modelNodes.end() );
+
+        if( firstInstance )
+        {
+            node = aModel.modelNodes.insert( std::make_pair( modelFileName.GetFullPath(),
+                                                             std::string() ) ).first;
+        }
+        else if( node->second.empty() )
+        {
+            continue;
+        }
+
         // Only copy VRML files.
-        if( modelFileName.FileExists() && modelFileName.GetExt() == wxT( "wrl" ) )
+        if( !firstInstance
+            || ( modelFileName.FileExists() && modelFileName.GetExt() == wxT( "wrl" ) ) )
         {
-            if( aExport3DFiles )
+            if( firstInstance && aExport3DFiles )
             {
                 wxDateTime srcModTime = modelFileName.GetModificationTime();
                 wxDateTime destModTime = srcModTime;
@@ -1295,7 +1318,19 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb, MODULE* aModule
             aOutputFile << ( vrmlm->m_MatScale.x * aVRMLModelsToBiu ) << " ";
             aOutputFile << ( vrmlm->m_MatScale.y * aVRMLModelsToBiu ) << " ";
             aOutputFile << ( vrmlm->m_MatScale.z * aVRMLModelsToBiu ) << "\n";
-            aOutputFile << "  children [\n    Inline {\n      url \"";
+
+            if( !firstInstance )
+            {
+                aOutputFile << "  children [ USE " << node->second << " ]\n";
+                aOutputFile << "  }\n";
+                continue;
+            }
+
+            node->second = TO_UTF8( wxString::Format( wxT( "KICAD_MODEL_%u" ),
+                                                      (unsigned) aModel.modelNodes.size() ) );
+
+            aOutputFile << "  children [\n    DEF " << node->second;
+            aOutputFile << " Inline {\n      url \"";
 
             if( aUseRelativePaths )
             {
@@ -81,6 +81,7 @@ PCB_PLOT_PARAMS::PCB_PLOT_PARAMS()
 {
     m_useGerberProtelExtensions  = false;
     m_useGerberAttributes        = false;
+    m_useGerberRegions           = false;
     m_gerberPrecision            = gbrDefaultPrecision;
     m_excludeEdgeLayer           = true;
     m_lineWidth                  = g_DrawDefaultLineThickness;
@@ -150,6 +151,10 @@ void PCB_PLOT_PARAMS::Format( OUTPUTFORMATTER* aFormatter,
                                 // to avoid incompatibility with older Pcbnew version
         aFormatter->Print( aNestLevel+1, "(%s %s)\n", getTokenName( T_usegerberattributes ), trueStr );
 
+    if( m_useGerberRegions )    // save this option only if active,
+                                // to avoid incompatibility with older Pcbnew version
+        aFormatter->Print( aNestLevel+1, "(%s %s)\n", getTokenName( T_usegerberregions ), trueStr );
+
     if( m_gerberPrecision != gbrDefaultPrecision ) // save this option only if it is not the default value,
                                                    // to avoid incompatibility with older Pcbnew version
         aFormatter->Print( aNestLevel+1, "(%s %d)\n",
@@ -222,6 +227,8 @@ bool PCB_PLOT_PARAMS::operator==( const PCB_PLOT_PARAMS &aPcbPlotParams ) const
         return false;
     if( m_useGerberAttributes != aPcbPlotParams.m_useGerberAttributes )
         return false;
+    if( m_useGerberRegions != aPcbPlotParams.m_useGerberRegions )
+        return false;
     if( m_gerberPrecision != aPcbPlotParams.m_gerberPrecision )
         return false;
     if( m_excludeEdgeLayer != aPcbPlotParams.m_excludeEdgeLayer )
@@ -384,6 +391,10 @@ void PCB_PLOT_PARAMS_PARSER::Parse( PCB_PLOT_PARAMS* aPcbPlotParams )
             aPcbPlotParams->m_useGerberAttributes = parseBool();
             break;
 
+        case T_usegerberregions:
+            aPcbPlotParams->m_useGerberRegions = parseBool();
+            break;
+
         case T_gerberprecision:
             aPcbPlotParams->m_gerberPrecision =
                 parseInt( gbrDefaultPrecision-1, gbrDefaultPrecision);
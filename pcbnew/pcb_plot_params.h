@@ -97,6 +97,10 @@ private:
     /// Include attributes from the Gerber X2 format (chapter 5 in revision J2)
     bool        m_useGerberAttributes;
 
+    /** Plot the filled areas of each zone as a single G36/G37 region, instead of
+     * a region per area or the fill segments */
+    bool        m_useGerberRegions;
+
     /// precision of coordinates in Gerber files: accepted 5 or 6
     /// when units are in mm (6 or 7 in inches, but Pcbnew uses mm).
     /// 6 is the internal resolution of Pcbnew, but not alwys accepted by board maker
@@ -231,6 +235,9 @@ public:
     void        SetUseGerberAttributes( bool aUse ) { m_useGerberAttributes = aUse; }
     bool        GetUseGerberAttributes() const { return m_useGerberAttributes; }
 
+    void        SetUseGerberRegions( bool aUse ) { m_useGerberRegions = aUse; }
+    bool        GetUseGerberRegions() const { return m_useGerberRegions; }
+
     void        SetUseGerberProtelExtensions( bool aUse ) { m_useGerberProtelExtensions = aUse; }
     bool        GetUseGerberProtelExtensions() const { return m_useGerberProtelExtensions; }
 
@@ -365,31 +365,41 @@ bool PLOT_CONTROLLER::OpenPlotfile( const wxString &aSuffix,
 
     // Now compute the full filename for the output and start the plot
     // (after ensuring the output directory is OK)
+    if( buildPlotFileName( m_plotFile, aSuffix, aFormat ) )
+    {
+        m_plotter = StartPlotBoard( m_board, &GetPlotOptions(), ToLAYER_ID( GetLayer() ),
+                                    m_plotFile.GetFullPath(), aSheetDesc );
+    }
+
+    return( m_plotter != NULL );
+}
+
+
+bool PLOT_CONTROLLER::buildPlotFileName( wxFileName& aPlotFile, const wxString& aSuffix,
+                                         PlotFormat aFormat )
+{
     wxString outputDirName = GetPlotOptions().GetOutputDirectory() ;
     wxFileName outputDir = wxFileName::DirName( outputDirName );
     wxString boardFilename = m_board->GetFileName();
 
-    if( EnsureFileDirectoryExists( &outputDir, boardFilename ) )
-    {
-        // outputDir contains now the full path of plot files
-        m_plotFile = boardFilename;
-        m_plotFile.SetPath( outputDir.GetPath() );
-        wxString fileExt = GetDefaultPlotExtension( aFormat );
+    if( !EnsureFileDirectoryExists( &outputDir, boardFilename ) )
+        return false;
 
-        // Gerber format can use specific file ext, depending on layers
-        // (now not a good practice, because the official file ext is .gbr)
-        if( GetPlotOptions().GetFormat() == PLOT_FORMAT_GERBER &&
-            GetPlotOptions().GetUseGerberProtelExtensions() )
-            fileExt = GetGerberProtelExtension( GetLayer() );
+    // outputDir contains now the full path of plot files
+    aPlotFile = boardFilename;
+    aPlotFile.SetPath( outputDir.GetPath() );
+    wxString fileExt = GetDefaultPlotExtension( aFormat );
 
-        // Build plot filenames from the board name and layer names:
-        BuildPlotFileName( &m_plotFile, outputDir.GetPath(), aSuffix, fileExt );
+    // Gerber format can use specific file ext, depending on layers
+    // (now not a good practice, because the official file ext is .gbr)
+    if( aFormat == PLOT_FORMAT_GERBER &&
+        GetPlotOptions().GetUseGerberProtelExtensions() )
+        fileExt = GetGerberProtelExtension( GetLayer() );
 
-        m_plotter = StartPlotBoard( m_board, &GetPlotOptions(), ToLAYER_ID( GetLayer() ),
-                                    m_plotFile.GetFullPath(), aSheetDesc );
-    }
+    // Build plot filenames from the board name and layer names:
+    BuildPlotFileName( &aPlotFile, outputDir.GetPath(), aSuffix, fileExt );
 
-    return( m_plotter != NULL );
+    return true;
 }
 
 
@@ -408,6 +418,33 @@ bool PLOT_CONTROLLER::PlotLayer()
 }
 
 
+bool PLOT_CONTROLLER::AddPlotJob( const wxString &aSuffix,
+                                  PlotFormat     aFormat,
+                                  const wxString &aSheetDesc )
+{
+    wxFileName plotFile;
+
+    if( !buildPlotFileName( plotFile, aSuffix, aFormat ) )
+        return false;
+
+    m_plotJobs.push_back( PLOT_JOB( ToLAYER_ID( GetLayer() ), aFormat,
+                                    plotFile.GetFullPath(), aSheetDesc ) );
+    return true;
+}
+
+
+int PLOT_CONTROLLER::PlotJobs()
+{
+    LOCALE_IO toggle;
+
+    int plotted = PlotBoardLayers( m_board, GetPlotOptions(), m_plotJobs );
+
+    m_plotJobs.clear();
+
+    return plotted;
+}
+
+
 void PLOT_CONTROLLER::SetColorMode( bool aColorMode )
 {
     if( !m_plotter )
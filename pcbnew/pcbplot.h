@@ -29,6 +29,7 @@
 #ifndef PCBPLOT_H_
 #define PCBPLOT_H_
 
+#include <vector>
 #include <wx/filename.h>
 #include <pad_shapes.h>
 #include <pcb_plot_params.h>
@@ -183,6 +184,45 @@ PLOTTER* StartPlotBoard( BOARD* aBoard,
 void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
                         const PCB_PLOT_PARAMS& aPlotOpt );
 
+/**
+ * Struct PLOT_JOB
+ * describes one plot file of a PlotBoardLayers() batch: a layer plotted in a given format.
+ */
+struct PLOT_JOB
+{
+    LAYER_ID    m_Layer;
+    PlotFormat  m_Format;
+    wxString    m_FileName;         ///< full path of the plot file
+    wxString    m_SheetDesc;
+    bool        m_Plotted;          ///< set by PlotBoardLayers(): false if the file was not created
+
+    PLOT_JOB( LAYER_ID aLayer, PlotFormat aFormat, const wxString& aFileName = wxEmptyString,
+              const wxString& aSheetDesc = wxEmptyString ) :
+        m_Layer( aLayer ),
+        m_Format( aFormat ),
+        m_FileName( aFileName ),
+        m_SheetDesc( aSheetDesc ),
+        m_Plotted( false )
+    {
+    }
+};
+
+/**
+ * Function PlotBoardLayers
+ * plots each job of \a aJobs in its own file, with its own plotter.  The files are
+ * written concurrently when built with OpenMP, and are identical to the files written
+ * one at a time by StartPlotBoard() and PlotOneBoardLayer().
+ * The board is not modified, but must not be modified by an other thread meanwhile,
+ * and the file names of the jobs must be different.
+ * The caller must keep the C locale (a LOCALE_IO) during the call.
+ * @param aBoard = the board to plot
+ * @param aPlotOpts = the plot options, the format is the one of each job
+ * @param aJobs = the layers to plot; their m_Plotted flag is set on return
+ * @return the number of files created
+ */
+int PlotBoardLayers( BOARD* aBoard, const PCB_PLOT_PARAMS& aPlotOpts,
+                     std::vector<PLOT_JOB>& aJobs );
+
 /**
  * Function PlotStandardLayer
  * plot copper or technical layers.
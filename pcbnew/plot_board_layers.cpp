@@ -51,6 +51,8 @@
 #include <pcbnew.h>
 #include <pcbplot.h>
 
+#include <memory>
+
 // Local
 /* Plot a solder mask layer.
  * Solder mask layers have a minimum thickness value and cannot be drawn like standard layers,
@@ -365,16 +367,25 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             if( pad->GetLayerSet()[F_Cu] )
                 color = ColorFromInt( color | aBoard->GetVisibleElementColor( PAD_FR_VISIBLE ) );
 
-            // Temporary set the pad size to the required plot size:
-            wxSize tmppadsize = pad->GetSize();
-            pad->SetSize( padPlotsSize );
-            switch( pad->GetShape() )
+            // Plot a copy of the pad with the required plot size: the board must
+            // not be modified, other layers can be plotted from it at the same time.
+            D_PAD*                  plotpad = pad;
+            std::unique_ptr<D_PAD>  sizedpad;
+
+            if( padPlotsSize != pad->GetSize() )
+            {
+                sizedpad.reset( new D_PAD( *pad ) );
+                sizedpad->SetSize( padPlotsSize );
+                plotpad = sizedpad.get();
+            }
+
+            switch( plotpad->GetShape() )
             {
             case PAD_SHAPE_CIRCLE:
             case PAD_SHAPE_OVAL:
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
-                    (pad->GetSize() == pad->GetDrillSize()) &&
-                    (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED) )
+                    (plotpad->GetSize() == plotpad->GetDrillSize()) &&
+                    (plotpad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED) )
                     break;
 
                 // Fall through:
@@ -382,11 +393,9 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             case PAD_SHAPE_RECT:
             case PAD_SHAPE_ROUNDRECT:
             default:
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( plotpad, color, plotMode );
                 break;
             }
-
-            pad->SetSize( tmppadsize );     // Restore the pad size
         }
     }
 
@@ -561,26 +570,15 @@ void PlotLayerOutlines( BOARD* aBoard, PLOTTER* aPlotter,
 
         outlines.Simplify( SHAPE_POLY_SET::PM_FAST );
 
-        // Plot outlines
-        std::vector< wxPoint > cornerList;
-
         // Now we have one or more basic polygons: plot each polygon
+        // (PlotPoly() closes them)
         for( int ii = 0; ii < outlines.OutlineCount(); ii++ )
         {
             for(int kk = 0; kk <= outlines.HoleCount (ii); kk++ )
             {
-                cornerList.clear();
                 const SHAPE_LINE_CHAIN& path = (kk == 0) ? outlines.COutline( ii ) : outlines.CHole( ii, kk - 1 );
 
-                for( int jj = 0; jj < path.PointCount(); jj++ )
-                    cornerList.push_back( wxPoint( path.CPoint( jj ).x , path.CPoint( jj ).y ) );
-
-
-                // Ensure the polygon is closed
-                if( cornerList[0] != cornerList[cornerList.size() - 1] )
-                    cornerList.push_back( cornerList[0] );
-
-                aPlotter->PlotPoly( cornerList, NO_FILL );
+                aPlotter->PlotPoly( path, NO_FILL );
             }
         }
 
@@ -1021,3 +1019,50 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts,
     delete plotter;
     return NULL;
 }
+
+
+int PlotBoardLayers( BOARD* aBoard, const PCB_PLOT_PARAMS& aPlotOpts,
+                     std::vector<PLOT_JOB>& aJobs )
+{
+    int count = aJobs.size();
+
+    // Each job has its own plotter and its own copy of the options. Starting a plot
+    // updates the board bounding box and reads the page layout, so the plotters are
+    // started one at a time; the layers themselves are plotted concurrently.
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for( int ii = 0; ii < count; ii++ )
+    {
+        PLOT_JOB&       job = aJobs[ii];
+        PCB_PLOT_PARAMS plotOpts = aPlotOpts;
+        PLOTTER*        plotter;
+
+        plotOpts.SetFormat( job.m_Format );
+
+#ifdef USE_OPENMP
+        #pragma omp critical( StartPlotBoard )
+#endif
+        plotter = StartPlotBoard( aBoard, &plotOpts, job.m_Layer, job.m_FileName,
+                                  job.m_SheetDesc );
+
+        job.m_Plotted = ( plotter != NULL );
+
+        if( plotter )
+        {
+            PlotOneBoardLayer( aBoard, plotter, job.m_Layer, plotOpts );
+            plotter->EndPlot();
+            delete plotter;
+        }
+    }
+
+    int plotted = 0;
+
+    for( unsigned ii = 0; ii < aJobs.size(); ii++ )
+    {
+        if( aJobs[ii].m_Plotted )
+            plotted++;
+    }
+
+    return plotted;
+}
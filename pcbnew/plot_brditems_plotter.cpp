@@ -501,70 +501,79 @@ void BRDITEMS_PLOTTER::PlotFilledAreas( ZONE_CONTAINER* aZone )
     if( polysList.IsEmpty() )
         return;
 
-    // We need a buffer to store corners coordinates:
-    static std::vector< wxPoint > cornerList;
-    cornerList.clear();
-
     m_plotter->SetColor( getColor( aZone->GetLayer() ) );
 
+    // With Gerber regions, all the filled areas of the zone are plotted as a single
+    // region, whatever the fill mode; only their thick outlines are plotted below.
+    bool plotRegions = GetPlotMode() == FILLED && GetUseGerberRegions() &&
+                       m_plotter->GetPlotterType() == PLOT_FORMAT_GERBER;
+
+    if( plotRegions )
+        static_cast<GERBER_PLOTTER*>( m_plotter )->PlotRegions( polysList );
+
     /* Plot all filled areas: filled areas have a filled area and a thick
      * outline we must plot the filled area itself ( as a filled polygon
      * OR a set of segments ) and plot the thick outline itself
      *
      * in non filled mode the outline is plotted, but not the filling items
      */
-    for( SHAPE_POLY_SET::CONST_ITERATOR ic =  polysList.CIterate(); ic; ++ic )
+    // The outlines are given to the plotter as they are stored in the zone: copying
+    // the corners of large copper pours would double the memory they use.
+    for( int ii = 0; ii < polysList.OutlineCount(); ii++ )
     {
-        wxPoint pos( ic->x, ic->y );
-        cornerList.push_back( pos );
+        const SHAPE_LINE_CHAIN& outline = polysList.COutline( ii );
 
-        if( ic.IsEndContour() )   // Plot the current filled area outline
+        // Plot the current filled area and its outline
+        if( GetPlotMode() == FILLED )
         {
-            // First, close the outline
-            if( cornerList[0] != cornerList[cornerList.size() - 1] )
+            // Plot the filled area polygon.
+            // The area can be filled by segments or uses solid polygons
+            if( plotRegions )
             {
-                cornerList.push_back( cornerList[0] );
+                if( aZone->GetMinThickness() > 0 )
+                    m_plotter->PlotPoly( outline, NO_FILL, aZone->GetMinThickness() );
             }
-
-            // Plot the current filled area and its outline
-            if( GetPlotMode() == FILLED )
+            else if( aZone->GetFillMode() == 0 ) // We are using solid polygons
             {
-                // Plot the filled area polygon.
-                // The area can be filled by segments or uses solid polygons
-                if( aZone->GetFillMode() == 0 ) // We are using solid polygons
+                m_plotter->PlotPoly( outline, FILLED_SHAPE, aZone->GetMinThickness() );
+            }
+            else    // We are using areas filled by segments: plot segments and outline
+            {
+                for( unsigned iseg = 0; iseg < aZone->FillSegments().size(); iseg++ )
                 {
-                    m_plotter->PlotPoly( cornerList, FILLED_SHAPE, aZone->GetMinThickness() );
+                    wxPoint start = aZone->FillSegments()[iseg].m_Start;
+                    wxPoint end   = aZone->FillSegments()[iseg].m_End;
+                    m_plotter->ThickSegment( start, end,
+                                             aZone->GetMinThickness(),
+                                             GetPlotMode() );
                 }
-                else    // We are using areas filled by segments: plot segments and outline
-                {
-                    for( unsigned iseg = 0; iseg < aZone->FillSegments().size(); iseg++ )
-                    {
-                        wxPoint start = aZone->FillSegments()[iseg].m_Start;
-                        wxPoint end   = aZone->FillSegments()[iseg].m_End;
-                        m_plotter->ThickSegment( start, end,
-                                                 aZone->GetMinThickness(),
-                                                 GetPlotMode() );
-                    }
 
                 // Plot the area outline only
                 if( aZone->GetMinThickness() > 0 )
-                    m_plotter->PlotPoly( cornerList, NO_FILL, aZone->GetMinThickness() );
-                }
+                    m_plotter->PlotPoly( outline, NO_FILL, aZone->GetMinThickness() );
             }
-            else
+        }
+        else
+        {
+            if( aZone->GetMinThickness() > 0 )
             {
-                if( aZone->GetMinThickness() > 0 )
+                // The outline is closed: the last segment ends on the first corner
+                int count = outline.PointCount();
+
+                for( int jj = 1; jj <= count; jj++ )
                 {
-                    for( unsigned jj = 1; jj<cornerList.size(); jj++ )
-                        m_plotter->ThickSegment( cornerList[jj -1], cornerList[jj],
+                    const VECTOR2I& start = outline.CPoint( jj - 1 );
+                    const VECTOR2I& end   = outline.CPoint( jj );   // CPoint( count ) is CPoint( 0 )
+
+                    if( start != end )
+                        m_plotter->ThickSegment( wxPoint( start.x, start.y ),
+                                                 wxPoint( end.x, end.y ),
                                                  aZone->GetMinThickness(),
                                                  GetPlotMode() );
                 }
-
-                m_plotter->SetCurrentLineWidth( -1 );
             }
 
-            cornerList.clear();
+            m_plotter->SetCurrentLineWidth( -1 );
         }
     }
 }
@@ -32,6 +32,7 @@
 
 #include <pcb_plot_params.h>
 #include <layers_id_colors_and_visibility.h>
+#include <pcbplot.h>
 
 class PLOTTER;
 class BOARD;
@@ -84,6 +85,21 @@ public:
      */
     bool PlotLayer();
 
+    /** Queue the plot of the current layer (m_plotLayer) in its own plotfile,
+     * to be written by PlotJobs(); the arguments are the ones of OpenPlotfile()
+     * @return false if the output directory cannot be created
+     */
+    bool AddPlotJob( const wxString &aSuffix, PlotFormat aFormat,
+                     const wxString &aSheetDesc );
+
+    /** Plot all the queued layers, each one in its own plotfile and with its
+     * own plotter, using several threads when available. The files are the
+     * same as the ones plotted one at a time by OpenPlotfile() and PlotLayer().
+     * The queue is empty on return.
+     * @return the number of plotfiles created
+     */
+    int PlotJobs();
+
     /**
      * @return the current plot full filename, set by OpenPlotfile
      */
@@ -123,6 +139,16 @@ private:
 
     /// The current plot filename, set by OpenPlotfile
     wxFileName m_plotFile;
+
+    /// The plots queued by AddPlotJob()
+    std::vector<PLOT_JOB> m_plotJobs;
+
+    /** Build the full filename of a plotfile in the output directory, from
+     * the board filename, the suffix and the current layer
+     * @return false if the output directory cannot be created
+     */
+    bool buildPlotFileName( wxFileName& aPlotFile, const wxString& aSuffix,
+                            PlotFormat aFormat );
 };
 
 #endif
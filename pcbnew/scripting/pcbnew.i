@@ -146,6 +146,19 @@
 %include <class_netclass.h>
 %include <class_netinfo.h>
 
+// PLOTTER::formatInt() writes in a caller buffer: give it to python as a string
+%ignore PLOTTER::formatInt;
+%extend PLOTTER
+{
+    static std::string FormatInt( int aValue )
+    {
+        char    buffer[16];
+        char*   end = PLOTTER::formatInt( buffer, aValue );
+
+        return std::string( buffer, end );
+    }
+}
+
 %include <plotcontroller.h>
 %include <pcb_plot_params.h>
 %include <plot_common.h>
@@ -21,6 +21,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <climits>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 #include <wx/filename.h>
@@ -46,6 +48,171 @@
     } } while( 0 )
 
 
+// Powers of ten which are exactly representable as a double
+static const double s_pow10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+/**
+ * Function parseFloat
+ * converts the token [aToken, aToken + aLength) to a float without
+ * allocating and independently of the current locale. As with the stream
+ * extraction which this replaces, a token which does not start with a
+ * number yields 0.
+ *
+ * @return false if characters remain in the token after the number
+ */
+static bool parseFloat( const char* aToken, size_t aLength, float& aValue )
+{
+    const char* cp = aToken;
+    const char* ep = aToken + aLength;
+    bool neg = false;
+
+    aValue = 0.0;
+
+    if( cp < ep && ( '-' == *cp || '+' == *cp ) )
+        neg = ( '-' == *cp++ );
+
+    unsigned long long mantissa = 0;
+    int ndigits = 0;        // significant digits accumulated in the mantissa
+    int exponent = 0;
+    bool hasDigits = false;
+
+    while( cp < ep && *cp >= '0' && *cp <= '9' )
+    {
+        hasDigits = true;
+
+        if( ndigits < 19 )
+        {
+            mantissa = mantissa * 10 + ( *cp - '0' );
+
+            if( mantissa )
+                ++ndigits;
+        }
+        else
+        {
+            ++exponent;
+        }
+
+        ++cp;
+    }
+
+    if( cp < ep && '.' == *cp )
+    {
+        ++cp;
+
+        while( cp < ep && *cp >= '0' && *cp <= '9' )
+        {
+            hasDigits = true;
+
+            if( ndigits < 19 )
+            {
+                mantissa = mantissa * 10 + ( *cp - '0' );
+                --exponent;
+
+                if( mantissa )
+                    ++ndigits;
+            }
+
+            ++cp;
+        }
+    }
+
+    if( !hasDigits )
+        return true;
+
+    if( cp < ep && ( 'e' == *cp || 'E' == *cp ) )
+    {
+        const char* sp = cp++;
+        bool eneg = false;
+        int eval = 0;
+
+        if( cp < ep && ( '-' == *cp || '+' == *cp ) )
+            eneg = ( '-' == *cp++ );
+
+        if( cp < ep && *cp >= '0' && *cp <= '9' )
+        {
+            while( cp < ep && *cp >= '0' && *cp <= '9' )
+            {
+                if( eval < 10000 )
+                    eval = eval * 10 + ( *cp - '0' );
+
+                ++cp;
+            }
+
+            exponent += eneg ? -eval : eval;
+        }
+        else
+        {
+            // not an exponent; leave the 'e' as trailing garbage
+            cp = sp;
+        }
+    }
+
+    double val = (double) mantissa;
+
+    if( 0 == mantissa )
+        val = 0.0;
+    else if( exponent >= 0 && exponent <= 22 )
+        val *= s_pow10[exponent];
+    else if( exponent < 0 && exponent >= -22 )
+        val /= s_pow10[-exponent];
+    else
+        val *= pow( 10.0, exponent );
+
+    aValue = (float)( neg ? -val : val );
+
+    return cp == ep;
+}
+
+
+/**
+ * Function parseInt
+ * converts the decimal token [aToken, aToken + aLength) to an int; see parseFloat.
+ *
+ * @return false if characters remain in the token after the number
+ */
+static bool parseInt( const char* aToken, size_t aLength, int& aValue )
+{
+    const char* cp = aToken;
+    const char* ep = aToken + aLength;
+    bool neg = false;
+
+    aValue = 0;
+
+    if( cp < ep && ( '-' == *cp || '+' == *cp ) )
+        neg = ( '-' == *cp++ );
+
+    if( cp == ep || *cp < '0' || *cp > '9' )
+        return true;
+
+    long long val = 0;
+
+    while( cp < ep && *cp >= '0' && *cp <= '9' )
+    {
+        if( val <= INT_MAX )
+            val = val * 10 + ( *cp - '0' );
+
+        ++cp;
+    }
+
+    if( neg )
+        val = -val;
+
+    if( val > INT_MAX )
+        val = INT_MAX;
+    else if( val < INT_MIN )
+        val = INT_MIN;
+
+    aValue = (int) val;
+
+    return cp == ep;
+}
+
+
 WRLPROC::WRLPROC( LINE_READER* aLineReader )
 {
     m_fileVersion = VRML_INVALID;
@@ -237,6 +404,51 @@ bool WRLPROC::ReadGlob( std::string& aGlob )
 {
     aGlob.clear();
 
+    size_t start;
+    size_t length;
+
+    if( !readToken( start, length ) )
+        return false;
+
+    aGlob.assign( m_buf, start, length );
+    return true;
+}
+
+
+size_t WRLPROC::countValues( void ) const
+{
+    size_t nvalues = 0;
+    bool intoken = false;
+
+    for( size_t i = m_bufpos; i < m_buf.size(); ++i )
+    {
+        char c = m_buf[i];
+
+        if( ']' == c || '#' == c )
+            break;
+
+        if( c > 0x20 && ',' != c )
+        {
+            if( !intoken )
+                ++nvalues;
+
+            intoken = true;
+        }
+        else
+        {
+            intoken = false;
+        }
+    }
+
+    return nvalues;
+}
+
+
+bool WRLPROC::readToken( size_t& aStart, size_t& aLength )
+{
+    aStart = 0;
+    aLength = 0;
+
     if( !m_file )
     {
         m_error = "no open file";
@@ -256,23 +468,26 @@ bool WRLPROC::ReadGlob( std::string& aGlob )
     }
 
     size_t ssize = m_buf.size();
+    aStart = m_bufpos;
 
     while( m_bufpos < ssize && m_buf[m_bufpos] > 0x20 )
     {
         if( ',' == m_buf[m_bufpos] )
         {
             // the comma is a special instance of blank space
+            aLength = m_bufpos - aStart;
             ++m_bufpos;
             return true;
         }
 
         if( '{' == m_buf[m_bufpos] || '}' == m_buf[m_bufpos]
             || '[' == m_buf[m_bufpos] || ']' == m_buf[m_bufpos] )
-            return true;
+            break;
 
-        aGlob.append( 1, m_buf[m_bufpos++] );
+        ++m_bufpos;
     }
 
+    aLength = m_bufpos - aStart;
     return true;
 }
 
@@ -811,9 +1026,10 @@ bool WRLPROC::ReadSFFloat( float& aSFFloat )
             break;
     }
 
-    std::string tmp;
+    size_t tstart;
+    size_t tlen;
 
-    if( !ReadGlob( tmp ) )
+    if( !readToken( tstart, tlen ) )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -826,14 +1042,7 @@ bool WRLPROC::ReadSFFloat( float& aSFFloat )
         return false;
     }
 
-    std::istringstream istr;
-    istr.str( tmp );
-
-    istr >> aSFFloat;
-    tmp.clear();
-    istr >> tmp;
-
-    if( !tmp.empty() )
+    if( !parseFloat( m_buf.data() + tstart, tlen, aSFFloat ) )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -874,9 +1083,10 @@ bool WRLPROC::ReadSFInt( int& aSFInt32 )
             break;
     }
 
-    std::string tmp;
+    size_t tstart;
+    size_t tlen;
 
-    if( !ReadGlob( tmp ) )
+    if( !readToken( tstart, tlen ) )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -889,24 +1099,18 @@ bool WRLPROC::ReadSFInt( int& aSFInt32 )
         return false;
     }
 
-    if( std::string::npos != tmp.find( "0x" ) )
+    if( tlen > 2 && '0' == m_buf[tstart]
+        && ( 'x' == m_buf[tstart + 1] || 'X' == m_buf[tstart + 1] ) )
     {
         // Rules: "0x" + "0-9, A-F" - VRML is case sensitive but in
         // this instance we do no enforce case.
         std::stringstream sstr;
-        sstr << std::hex << tmp;
+        sstr << std::hex << m_buf.substr( tstart, tlen );
         sstr >> aSFInt32;
         return true;
     }
 
-    std::istringstream istr;
-    istr.str( tmp );
-
-    istr >> aSFInt32;
-    tmp.clear();
-    istr >> tmp;
-
-    if( !tmp.empty() )
+    if( !parseInt( m_buf.data() + tstart, tlen, aSFInt32 ) )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -951,12 +1155,13 @@ bool WRLPROC::ReadSFRotation( WRLROTATION& aSFRotation )
             break;
     }
 
-    std::string tmp;
+    size_t tstart;
+    size_t tlen;
     float trot[4];
 
     for( int i = 0; i < 4; ++i )
     {
-        if( !ReadGlob( tmp ) )
+        if( !readToken( tstart, tlen ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -969,14 +1174,7 @@ bool WRLPROC::ReadSFRotation( WRLROTATION& aSFRotation )
             return false;
         }
 
-        std::istringstream istr;
-        istr.str( tmp );
-
-        istr >> trot[i];
-        tmp.clear();
-        istr >> tmp;
-
-        if( !tmp.empty() )
+        if( !parseFloat( m_buf.data() + tstart, tlen, trot[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1026,13 +1224,14 @@ bool WRLPROC::ReadSFVec2f( WRLVEC2F& aSFVec2f )
             break;
     }
 
-    std::string tmp;
+    size_t tstart;
+    size_t tlen;
 
     float tcol[2];
 
     for( int i = 0; i < 2; ++i )
     {
-        if( !ReadGlob( tmp ) )
+        if( !readToken( tstart, tlen ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1045,14 +1244,7 @@ bool WRLPROC::ReadSFVec2f( WRLVEC2F& aSFVec2f )
             return false;
         }
 
-        std::istringstream istr;
-        istr.str( tmp );
-
-        istr >> tcol[i];
-        tmp.clear();
-        istr >> tmp;
-
-        if( !tmp.empty() )
+        if( !parseFloat( m_buf.data() + tstart, tlen, tcol[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1101,13 +1293,14 @@ bool WRLPROC::ReadSFVec3f( WRLVEC3F& aSFVec3f )
             break;
     }
 
-    std::string tmp;
+    size_t tstart;
+    size_t tlen;
 
     float tcol[3];
 
     for( int i = 0; i < 3; ++i )
     {
-        if( !ReadGlob( tmp ) )
+        if( !readToken( tstart, tlen ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1120,21 +1313,7 @@ bool WRLPROC::ReadSFVec3f( WRLVEC3F& aSFVec3f )
             return false;
         }
 
-        // ignore any commas
-        if( !EatSpace() )
-            return false;
-
-        if( ',' == m_buf[m_bufpos] )
-            Pop();
-
-        std::istringstream istr;
-        istr.str( tmp );
-
-        istr >> tcol[i];
-        tmp.clear();
-        istr >> tmp;
-
-        if( !tmp.empty() )
+        if( !parseFloat( m_buf.data() + tstart, tlen, tcol[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1147,6 +1326,14 @@ bool WRLPROC::ReadSFVec3f( WRLVEC3F& aSFVec3f )
             return false;
         }
 
+        // ignore any commas; the token must be parsed first since this
+        // may advance the buffer to the next line
+        if( !EatSpace() )
+            return false;
+
+        if( ',' == m_buf[m_bufpos] )
+            Pop();
+
     }
 
     aSFVec3f.x = tcol[0];
@@ -1338,6 +1525,7 @@ bool WRLPROC::ReadMFColor( std::vector< WRLVEC3F >& aMFColor )
     }
 
     ++m_bufpos;
+    aMFColor.reserve( countValues() / 3 );
 
     while( true )
     {
@@ -1450,6 +1638,7 @@ bool WRLPROC::ReadMFFloat( std::vector< float >& aMFFloat )
     }
 
     ++m_bufpos;
+    aMFFloat.reserve( countValues() );
 
     while( true )
     {
@@ -1562,6 +1751,7 @@ bool WRLPROC::ReadMFInt( std::vector< int >& aMFInt32 )
     }
 
     ++m_bufpos;
+    aMFInt32.reserve( countValues() );
 
     while( true )
     {
@@ -1674,6 +1864,7 @@ bool WRLPROC::ReadMFRotation( std::vector< WRLROTATION >& aMFRotation )
     }
 
     ++m_bufpos;
+    aMFRotation.reserve( countValues() / 4 );
 
     while( true )
     {
@@ -1786,6 +1977,7 @@ bool WRLPROC::ReadMFVec2f( std::vector< WRLVEC2F >& aMFVec2f )
     }
 
     ++m_bufpos;
+    aMFVec2f.reserve( countValues() / 2 );
 
     while( true )
     {
@@ -1898,6 +2090,7 @@ bool WRLPROC::ReadMFVec3f( std::vector< WRLVEC3F >& aMFVec3f )
     }
 
     ++m_bufpos;
+    aMFVec3f.reserve( countValues() / 3 );
 
     while( true )
     {
@@ -58,6 +58,16 @@ private:
     // parameters are updated as appropriate.
     bool getRawLine( void );
 
+    // readToken is ReadGlob without the copy; it returns the position and
+    // length of the token within m_buf. The token is only valid until the
+    // next call which may advance to a new line.
+    bool readToken( size_t& aStart, size_t& aLength );
+
+    // countValues returns the number of values left in the current line before
+    // the end of a MF field; it is used as a reserve hint by the ReadMF* functions
+    // and does not include the values of the next lines.
+    size_t countValues( void ) const;
+
 public:
     WRLPROC( LINE_READER* aLineReader );
     ~WRLPROC();
@@ -0,0 +1,88 @@
+import os
+import re
+import shutil
+import tempfile
+import unittest
+
+from pcbnew import *
+
+
+# Lines holding the plot date, which differs from one plot to the next, and
+# the PostScript title, which holds the full path of the file
+DATE_LINE = re.compile(r'CreationDate|Created by KiCad|SVG Picture created as|^%%Title:')
+
+# The text heavy layers of the test board, and a few copper ones
+PLOT_PLAN = [
+    ( "SilkTop", F_SilkS ),
+    ( "SilkBottom", B_SilkS ),
+    ( "FabTop", F_Fab ),
+    ( "CuTop", F_Cu ),
+    ( "CuBottom", B_Cu ),
+    ( "EdgeCuts", Edge_Cuts ),
+]
+
+PLOT_FORMATS = [ PLOT_FORMAT_GERBER, PLOT_FORMAT_POST, PLOT_FORMAT_SVG ]
+
+
+def read_plot(filename):
+    with open(filename, 'rb') as plotfile:
+        return [line for line in plotfile.read().splitlines()
+                if not DATE_LINE.search(line.decode('latin-1'))]
+
+
+class TestPlotLayers(unittest.TestCase):
+
+    def setUp(self):
+        self.pcb = LoadBoard("data/complex_hierarchy.kicad_pcb")
+        self.seq_dir = tempfile.mkdtemp()
+        self.par_dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.seq_dir)
+        shutil.rmtree(self.par_dir)
+
+    def set_options(self, pctl, outputDir):
+        popt = pctl.GetPlotOptions()
+        popt.SetOutputDirectory(outputDir)
+        popt.SetPlotFrameRef(False)
+        popt.SetPlotReference(True)
+        popt.SetPlotValue(True)
+        popt.SetPlotInvisibleText(True)
+        popt.SetUseGerberAttributes(False)
+
+    def test_plot_jobs_match_sequential_plot(self):
+        # One file at a time, through the plotter of the controller
+        pctl = PLOT_CONTROLLER(self.pcb)
+        self.set_options(pctl, self.seq_dir)
+
+        for plot_format in PLOT_FORMATS:
+            for suffix, layer in PLOT_PLAN:
+                pctl.SetLayer(layer)
+                self.assertTrue(pctl.OpenPlotfile(suffix, plot_format, suffix))
+                self.assertTrue(pctl.PlotLayer())
+
+        pctl.ClosePlot()
+
+        # All the files at once, concurrently when built with OpenMP
+        pctl = PLOT_CONTROLLER(self.pcb)
+        self.set_options(pctl, self.par_dir)
+
+        for plot_format in PLOT_FORMATS:
+            for suffix, layer in PLOT_PLAN:
+                pctl.SetLayer(layer)
+                self.assertTrue(pctl.AddPlotJob(suffix, plot_format, suffix))
+
+        self.assertEqual(pctl.PlotJobs(), len(PLOT_FORMATS) * len(PLOT_PLAN))
+
+        seq_files = sorted(os.listdir(self.seq_dir))
+        self.assertEqual(seq_files, sorted(os.listdir(self.par_dir)))
+        self.assertEqual(len(seq_files), len(PLOT_FORMATS) * len(PLOT_PLAN))
+
+        for name in seq_files:
+            self.assertEqual(read_plot(os.path.join(self.seq_dir, name)),
+                             read_plot(os.path.join(self.par_dir, name)),
+                             name + " differs from the sequential plot")
+
+
+if __name__ == '__main__':
+    unittest.main()
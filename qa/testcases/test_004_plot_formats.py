@@ -0,0 +1,117 @@
+import os
+import random
+import re
+import shutil
+import tempfile
+import unittest
+
+from pcbnew import *
+
+
+# Lines holding the plot date, which differs from one plot to the next, and
+# the PostScript title, which holds the full path of the file
+DATE_LINE = re.compile(r'CreationDate|Created by KiCad|SVG Picture created as|^%%Title:')
+
+PLOT_PLAN = [
+    ( "CuTop", F_Cu ),
+    ( "SilkTop", F_SilkS ),
+    ( "EdgeCuts", Edge_Cuts ),
+]
+
+PLOT_FORMATS = [ PLOT_FORMAT_GERBER, PLOT_FORMAT_POST, PLOT_FORMAT_SVG ]
+
+INT_MIN = -2 ** 31
+INT_MAX = 2 ** 31 - 1
+
+# A Gerber flash or vertex: X<int>Y<int>D<2 digits>*, the ints as written by "%d"
+INT = r'(0|-?[1-9][0-9]*)'
+GERBER_DCODE = re.compile(r'^X' + INT + 'Y' + INT + r'D[0-9]{2,}\*$')
+# A SVG polyline point: <int>,<int>
+SVG_POINT = re.compile(r'^' + INT + ',' + INT + '$')
+
+
+def read_plot(filename):
+    with open(filename, 'rb') as plotfile:
+        return [line for line in plotfile.read().splitlines()
+                if not DATE_LINE.search(line.decode('latin-1'))]
+
+
+class TestPlotFormats(unittest.TestCase):
+
+    def setUp(self):
+        self.pcb = LoadBoard("data/complex_hierarchy.kicad_pcb")
+        self.plot_dir = tempfile.mkdtemp()
+
+        pctl = PLOT_CONTROLLER(self.pcb)
+        popt = pctl.GetPlotOptions()
+        popt.SetOutputDirectory(self.plot_dir)
+        popt.SetPlotFrameRef(False)
+        popt.SetUseGerberAttributes(False)
+        popt.SetUseGerberProtelExtensions(False)
+
+        for plot_format in PLOT_FORMATS:
+            for suffix, layer in PLOT_PLAN:
+                pctl.SetLayer(layer)
+                self.assertTrue(pctl.OpenPlotfile(suffix, plot_format, suffix))
+                self.assertTrue(pctl.PlotLayer())
+
+        pctl.ClosePlot()
+
+        self.plot_files = sorted(os.listdir(self.plot_dir))
+
+    def tearDown(self):
+        shutil.rmtree(self.plot_dir)
+
+    def test_plot_files_created(self):
+        self.assertEqual(len(self.plot_files), len(PLOT_FORMATS) * len(PLOT_PLAN))
+
+    def test_plot_coordinates_format(self):
+        gerber_dcodes = 0
+        svg_points = 0
+
+        for name in self.plot_files:
+            lines = read_plot(os.path.join(self.plot_dir, name))
+
+            if name.endswith(".gbr"):
+                for line in lines:
+                    if line.startswith(b'X'):
+                        self.assertTrue(GERBER_DCODE.match(line.decode('latin-1')),
+                                        name + ": " + line.decode('latin-1'))
+                        gerber_dcodes += 1
+
+            elif name.endswith(".svg"):
+                for line in lines:
+                    # the first point of a polyline follows the points attribute
+                    if line.startswith(b'points="'):
+                        line = line[len(b'points="'):]
+
+                    if line[:1].isdigit() or line.startswith(b'-'):
+                        self.assertTrue(SVG_POINT.match(line.decode('latin-1')),
+                                        name + ": " + line.decode('latin-1'))
+                        svg_points += 1
+
+        self.assertTrue(gerber_dcodes > 0)
+        self.assertTrue(svg_points > 0)
+
+
+class TestFormatInt(unittest.TestCase):
+
+    def test_format_int_matches_printf(self):
+        # PLOTTER::formatInt() must write the same text as "%d", which the plotters
+        # used before: check the limits and both sides of each power of ten
+        values = [INT_MIN, INT_MIN + 1, INT_MAX - 1, INT_MAX, -1, 0, 1]
+
+        for power in range(1, 10):
+            for value in (10 ** power - 1, 10 ** power, 10 ** power + 1):
+                values.append(value)
+                values.append(-value)
+
+        generator = random.Random(4242)
+        values.extend(generator.randint(INT_MIN, INT_MAX) for ii in range(1000))
+
+        for value in values:
+            self.assertEqual(PLOTTER.FormatInt(value), "%d" % value)
+
+
+if __name__ == '__main__':
+    unittest.main()